@@ -0,0 +1,110 @@
+/**
+ * Copyright © 2022 by Karthik Jain <krthkj.public@gmail.com>
+ * All Rights Reserved.
+ * Using MIT licence, refer the license file supplied with the project.
+ *
+ * File : udemy1-benchmark.hpp
+ * Desc : Common helpers and list of all the benchmarks for the udemy1 library
+ *
+ * Author : Karthik Jain <krthkj.public@gmail.com>
+ * Date : 2026-10-17
+ *
+ */
+
+#ifndef UDEMY1_BENCHMARK_HPP
+#define UDEMY1_BENCHMARK_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+
+namespace udemy1::bench
+{
+
+/**
+ * @class Stopwatch
+ * @brief Wall clock timer, starts on construction
+ */
+class Stopwatch
+{
+  private:
+    std::chrono::steady_clock::time_point start;
+
+  public:
+    Stopwatch()
+        : start{std::chrono::steady_clock::now()}
+    {
+    }
+
+    void reset(void)
+    {
+        start = std::chrono::steady_clock::now();
+    }
+
+    double elapsed_ms(void) const
+    {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+};
+
+/**
+ * @brief Keep the optimiser from dropping a value that is never read
+ */
+template <typename T>
+inline void keep(const T& value)
+{
+    asm volatile("" : : "r"(&value) : "memory");
+}
+
+/**
+ * @brief Number of calls made to the global operator new so far (see alloc_counter.cpp)
+ */
+std::size_t alloc_count(void);
+
+/**
+ * @brief Bytes currently allocated on the heap (glibc mallinfo2)
+ */
+std::size_t heap_in_use(void);
+
+/**
+ * @brief Path of a file in the data/ directory, benchmarks run from cmake-build-Debug/output
+ */
+std::string data_file(const std::string& name);
+
+/**
+ * @brief Print one result line in a common format
+ */
+void report(const std::string& name, double value, const std::string& unit);
+
+/**
+ * @brief List of all the benchmarks, selected by name from main
+ */
+void mystring_run(void);
+void mystring_growth_run(void);
+void mystring_simd_run(void);
+void mystring_map_run(void);
+void atom_run(void);
+void movies_run(void);
+void movies_batch_run(void);
+void movies_file_run(void);
+void movie_table_run(void);
+void account_pool_run(void);
+void account_store_run(void);
+void money_run(void);
+void ledger_run(void);
+void journal_run(void);
+void print_sink_run(void);
+void s15c_posting_run(void);
+void s18c_result_run(void);
+void s19c3_search_run(void);
+void s19c3_parallel_run(void);
+void s19c3_keywords_run(void);
+void s20c3_count_run(void);
+void s20c3_incremental_run(void);
+void s20c3_index_run(void);
+void s20c3_parallel_run(void);
+void s20c3_query_run(void);
+
+} // namespace udemy1::bench
+
+#endif // UDEMY1_BENCHMARK_HPP
@@ -0,0 +1,88 @@
+/**
+ * Copyright © 2022 by Karthik Jain <krthkj.public@gmail.com>
+ * All Rights Reserved.
+ * Using MIT licence, refer the license file supplied with the project.
+ *
+ * File : alloc_counter.cpp
+ * Desc : Replaces the global operator new/delete to count heap allocations,
+ *        this includes the allocations done inside libudemy1.so
+ *
+ * Author : Karthik Jain <krthkj.public@gmail.com>
+ * Date : 2026-10-17
+ *
+ */
+
+#include "udemy1-benchmark.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <malloc.h>
+#include <new>
+
+namespace
+{
+std::atomic<std::size_t> allocations{0};
+}
+
+void* operator new(std::size_t size)
+{
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1))
+        return p;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+    return ::operator new(size);
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+namespace udemy1::bench
+{
+
+std::size_t alloc_count(void)
+{
+    return allocations.load(std::memory_order_relaxed);
+}
+
+std::size_t heap_in_use(void)
+{
+    // big blocks such as a vector's buffer are mmap'ed and not part of uordblks
+    const struct mallinfo2 info{mallinfo2()};
+    return info.uordblks + info.hblkhd;
+}
+
+std::string data_file(const std::string& name)
+{
+    return "../../data/" + name;
+}
+
+void report(const std::string& name, double value, const std::string& unit)
+{
+    std::cout << "  " << std::setw(44) << std::left << name << std::setw(14) << std::right << std::fixed
+              << std::setprecision(2) << value << " " << unit << std::endl;
+}
+
+} // namespace udemy1::bench
@@ -0,0 +1,634 @@
+/**
+ * Copyright © 2022 by Karthik Jain <krthkj.public@gmail.com>
+ * All Rights Reserved.
+ * Using MIT licence, refer the license file supplied with the project.
+ *
+ * File : bench_accounts.cpp
+ * Desc : Benchmarks for the account hierarchies (sections 15 to 18)
+ *
+ * Author : Karthik Jain <krthkj.public@gmail.com>
+ * Date : 2026-10-17
+ *
+ */
+
+#include "money.hpp"
+#include "s15c_account_util.hpp"
+#include "s15c_journal.hpp"
+#include "s15c_ledger.hpp"
+#include "s15c_posting.hpp"
+#include "s16c_class.hpp"
+#include "s18c_class.hpp"
+#include "udemy1-benchmark.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace udemy1::bench
+{
+
+namespace
+{
+constexpr int accounts{10'000};
+constexpr int postings{10'000'000};
+constexpr int latency_calls{1'000'000};
+constexpr int store_accounts{10'000'000};
+constexpr int money_accounts{10'000'000};
+constexpr int money_periods{12};
+constexpr int ledger_accounts{100'000};
+constexpr int journal_accounts{1000};
+constexpr int journal_ops{1'000'000};
+constexpr int journal_synced_ops{20'000};
+
+// deposits and withdrawals of 1 to 100 spread over every account
+std::vector<s15c::Posting> make_postings(int n, std::uint32_t account_count)
+{
+    std::vector<s15c::Posting> batch;
+    batch.reserve(n);
+    std::uint32_t seed{12345};
+    for (int i{0}; i < n; ++i) {
+        seed = seed * 1664525u + 1013904223u;
+        batch.push_back(s15c::Posting{static_cast<double>(1 + (seed >> 8) % 100), (seed >> 4) % account_count,
+                                      (seed >> 31) ? s15c::Op::withdraw : s15c::Op::deposit});
+    }
+    return batch;
+}
+/**
+ * @brief Time every call on its own and report the 50th and 99th percentile
+ */
+template <typename Op>
+void latency(const std::string& name, Op op)
+{
+    std::vector<std::int64_t> ns(latency_calls);
+    for (int i{0}; i < latency_calls; ++i) {
+        const auto start{std::chrono::steady_clock::now()};
+        op(i);
+        ns[i] = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+    }
+    std::sort(ns.begin(), ns.end());
+    report(name + " p50", static_cast<double>(ns[latency_calls / 2]), "ns");
+    report(name + " p99", static_cast<double>(ns[latency_calls * 99 / 100]), "ns");
+}
+} // namespace
+
+void s15c_posting_run(void)
+{
+    using namespace udemy1::s15c;
+    std::ofstream null_sink{"/dev/null"};
+    std::streambuf* const saved{std::cout.rdbuf(null_sink.rdbuf())};
+
+    // before: the util helpers, one account at a time with a line on std::cout each
+    std::vector<Checking_Account> checking(accounts, Checking_Account{"Checking", 1000.0});
+    Stopwatch sw;
+    for (int i{0}; i < 100; ++i) {
+        deposit(checking, 10.0);
+        withdraw(checking, 10.0);
+    }
+    double ms{sw.elapsed_ms()};
+    std::cout.rdbuf(saved);
+    report("util deposit/withdraw, checking", 2.0 * 100 * accounts / ms / 1e3, "M postings/s");
+
+    const std::vector<Posting> batch{make_postings(postings, accounts)};
+    std::vector<Post_result> results;
+
+    checking.assign(accounts, Checking_Account{"Checking", 1000.0});
+    sw.reset();
+    std::size_t posted{post(checking, batch, results)};
+    ms = sw.elapsed_ms();
+    keep(posted);
+    report("post, checking", postings / ms / 1e3, "M postings/s");
+
+    std::vector<Savings_Account> savings(accounts, Savings_Account{"Savings", 1000.0, 2.0});
+    sw.reset();
+    posted = post(savings, batch, results);
+    ms = sw.elapsed_ms();
+    keep(posted);
+    report("post, savings", postings / ms / 1e3, "M postings/s");
+
+    checking.assign(accounts, Checking_Account{"Checking", 1000.0});
+    sw.reset();
+    posted = post(checking, batch, results, &null_sink);
+    ms = sw.elapsed_ms();
+    keep(posted);
+    report("post, checking, log to /dev/null", postings / ms / 1e3, "M postings/s");
+
+    // the trust rules must come out exactly as with one call per transaction
+    std::vector<Trust_Account> batched(1000, Trust_Account{"Trust", 10000.0, 3.0});
+    std::vector<Trust_Account> one_by_one{batched};
+    std::vector<Posting> trust_batch{make_postings(100'000, 1000)};
+    for (std::size_t i{0}; i < trust_batch.size(); i += 7)
+        trust_batch[i].amount = 6000.0; // some bonus deposits, and withdrawals over 20%
+    posted = post(batched, trust_batch, results);
+    bool same{true};
+    for (std::size_t i{0}; i < trust_batch.size(); ++i) {
+        Trust_Account& acc{one_by_one[trust_batch[i].account]};
+        const bool done{trust_batch[i].op == Op::deposit ? acc.deposit(trust_batch[i].amount)
+                                                         : acc.withdraw(trust_batch[i].amount)};
+        same = same && ((results[i] == Post_result::ok) == done);
+    }
+    for (std::size_t i{0}; i < batched.size(); ++i)
+        same = same && batched[i].get_balance() == one_by_one[i].get_balance();
+    report("post, trust, same as one call each", same ? 1.0 : 0.0, same ? "(yes)" : "(NO)");
+    report("post, trust, postings accepted", static_cast<double>(posted), "");
+}
+
+void s18c_result_run(void)
+{
+    using namespace udemy1::s18c;
+
+    for (int percent : {0, 10, 50}) {
+        // the same accounts and amounts for both APIs, a failing withdrawal overdraws
+        std::vector<double> amount(latency_calls);
+        std::uint32_t seed{12345};
+        for (double& a : amount) {
+            seed = seed * 1664525u + 1013904223u;
+            a = ((seed >> 8) % 100 < static_cast<std::uint32_t>(percent)) ? 1e15 : 1.0;
+        }
+        const std::string tag{std::to_string(percent) + "% failing, "};
+
+        std::unique_ptr<Account> acc{std::make_unique<Savings_Account>("Savings", 1e12)};
+        long failed{0};
+        latency(tag + "withdraw", [&](int i) {
+            try {
+                acc->withdraw(amount[i]);
+            } catch (const InsufficentFundsException&) {
+                ++failed;
+            }
+        });
+
+        acc = std::make_unique<Savings_Account>("Savings", 1e12);
+        long try_failed{0};
+        latency(tag + "try_withdraw", [&](int i) { try_failed += !acc->try_withdraw(amount[i]); });
+        keep(failed);
+        if (failed != try_failed)
+            report(tag + "MISMATCHED FAILURES", static_cast<double>(failed - try_failed), "");
+    }
+}
+
+void account_store_run(void)
+{
+    using namespace udemy1::s16c;
+
+    // what the util helpers print for the vector and for the store must match
+    {
+        std::vector<Account*> pointers;
+        Account_store store;
+        for (int i{0}; i < 300; ++i) {
+            const std::string name{"Holder " + std::to_string(i)};
+            switch (i % 3) {
+            case 0:
+                pointers.push_back(new Checking{name, 100.0 * i});
+                store.add<Checking>(name, 100.0 * i);
+                break;
+            case 1:
+                pointers.push_back(new Savings{name, 100.0 * i, 2.5});
+                store.add<Savings>(name, 100.0 * i, 2.5);
+                break;
+            default:
+                pointers.push_back(new Trust{name, 100.0 * i, 1.5});
+                store.add<Trust>(name, 100.0 * i, 1.5);
+                break;
+            }
+        }
+        std::ostringstream by_pointer, by_store;
+        std::streambuf* const saved{std::cout.rdbuf(by_pointer.rdbuf())};
+        for (double amt : {6000.0, 25.0}) {
+            display(pointers);
+            deposit(pointers, amt);
+            withdraw(pointers, amt * 0.3);
+            withdraw(pointers, amt * 2);
+        }
+        std::cout.rdbuf(by_store.rdbuf());
+        for (double amt : {6000.0, 25.0}) {
+            display(store);
+            deposit(store, amt);
+            withdraw(store, amt * 0.3);
+            withdraw(store, amt * 2);
+        }
+        std::cout.rdbuf(saved);
+        for (Account* acc : pointers)
+            delete acc;
+        const bool same{by_pointer.str() == by_store.str()};
+        report("300 accounts, store prints like vector", same ? 1.0 : 0.0, same ? "(yes)" : "(NO)");
+    }
+
+    // before: one new'd object per account behind a base pointer
+    std::vector<Account*> pointers;
+    pointers.reserve(store_accounts);
+    Stopwatch sw;
+    for (int i{0}; i < store_accounts; ++i) {
+        switch (i % 3) {
+        case 0: pointers.push_back(new Checking{"Checking", 1000.0}); break;
+        case 1: pointers.push_back(new Savings{"Savings", 1000.0, 2.0}); break;
+        default: pointers.push_back(new Trust{"Trust", 1000.0, 2.0}); break;
+        }
+    }
+    report("vector<Account*> build 10M", sw.elapsed_ms(), "ms");
+
+    std::size_t done{0};
+    sw.reset();
+    for (Account* acc : pointers)
+        done += acc->deposit(10.0);
+    for (Account* acc : pointers)
+        done += acc->withdraw(5.0);
+    double ms{sw.elapsed_ms()};
+    keep(done);
+    report("vector<Account*> deposit + withdraw", ms / 2, "ms/pass");
+
+    Account_store store;
+    store.reserve(store_accounts);
+    sw.reset();
+    for (int i{0}; i < store_accounts; ++i) {
+        switch (i % 3) {
+        case 0: store.add<Checking>("Checking", 1000.0); break;
+        case 1: store.add<Savings>("Savings", 1000.0, 2.0); break;
+        default: store.add<Trust>("Trust", 1000.0, 2.0); break;
+        }
+    }
+    report("Account_store build 10M", sw.elapsed_ms(), "ms");
+
+    std::size_t store_done{0};
+    sw.reset();
+    store_done += store.deposit(10.0);
+    store_done += store.withdraw(5.0);
+    ms = sw.elapsed_ms();
+    report("Account_store deposit + withdraw", ms / 2, done == store_done ? "ms/pass" : "ms/pass, WRONG COUNT");
+
+    double pointer_total{0}, store_total{0};
+    for (const Account* acc : pointers)
+        pointer_total += acc->get_balance();
+    store.for_each([&store_total](const Account& acc) { store_total += acc.get_balance(); });
+    report("balances match", pointer_total == store_total ? 1.0 : 0.0, pointer_total == store_total ? "(yes)" : "(NO)");
+
+    for (Account* acc : pointers)
+        delete acc;
+}
+
+void account_pool_run(void)
+{
+    using namespace udemy1::s16c;
+
+    // mean distance in bytes from one account to the next, in the order they are visited
+    const auto mean_gap{[](const std::vector<Account*>& accs) {
+        double total{0};
+        for (std::size_t i{1}; i < accs.size(); ++i)
+            total += std::abs(static_cast<double>(reinterpret_cast<std::uintptr_t>(accs[i])) -
+                              static_cast<double>(reinterpret_cast<std::uintptr_t>(accs[i - 1])));
+        return total / static_cast<double>(accs.size() - 1);
+    }};
+    const auto pass{[](const std::vector<Account*>& accs) {
+        std::size_t done{0};
+        for (Account* acc : accs)
+            done += acc->deposit(10.0);
+        return done;
+    }};
+
+    // before: new and delete for every account
+    std::vector<Account*> pointers;
+    pointers.reserve(store_accounts);
+    std::size_t allocs{alloc_count()};
+    Stopwatch sw;
+    for (int i{0}; i < store_accounts; ++i) {
+        switch (i % 3) {
+        case 0: pointers.push_back(new Checking{"Checking", 1000.0}); break;
+        case 1: pointers.push_back(new Savings{"Savings", 1000.0, 2.0}); break;
+        default: pointers.push_back(new Trust{"Trust", 1000.0, 2.0}); break;
+        }
+    }
+    report("new build 10M", sw.elapsed_ms(), "ms");
+    report("new build allocations", static_cast<double>(alloc_count() - allocs), "calls");
+
+    // a long running program closes and opens accounts, the new ones land wherever malloc has room
+    std::mt19937 rng{7};
+    for (int round{0}; round < 2; ++round) {
+        for (std::size_t i{0}; i < pointers.size(); ++i)
+            if (rng() % 2) {
+                delete pointers[i];
+                pointers[i] = nullptr;
+            }
+        for (std::size_t i{0}; i < pointers.size(); ++i)
+            if (!pointers[i])
+                pointers[i] = new Savings{"Savings", 1000.0, 2.0};
+    }
+    sw.reset();
+    std::size_t done{pass(pointers)};
+    report("new deposit pass after churn", sw.elapsed_ms(), "ms");
+    report("new mean gap between accounts", mean_gap(pointers), "bytes");
+
+    sw.reset();
+    for (Account* acc : pointers)
+        delete acc;
+    report("delete 10M", sw.elapsed_ms(), "ms");
+    pointers.clear();
+
+    // after: the same accounts made in the pool, released with one clear
+    Account_pool pool;
+    pool.reserve(store_accounts, sizeof(Trust));
+    allocs = alloc_count();
+    sw.reset();
+    for (int i{0}; i < store_accounts; ++i) {
+        switch (i % 3) {
+        case 0: pool.make<Checking>("Checking", 1000.0); break;
+        case 1: pool.make<Savings>("Savings", 1000.0, 2.0); break;
+        default: pool.make<Trust>("Trust", 1000.0, 2.0); break;
+        }
+    }
+    report("Account_pool build 10M", sw.elapsed_ms(), "ms");
+    report("Account_pool build allocations", static_cast<double>(alloc_count() - allocs), "calls");
+
+    sw.reset();
+    const std::size_t pool_done{pass(pool.accounts())};
+    report("Account_pool deposit pass", sw.elapsed_ms(), pool_done == done ? "ms" : "ms, WRONG COUNT");
+    report("Account_pool mean gap between accounts", mean_gap(pool.accounts()), "bytes");
+
+    sw.reset();
+    pool.clear();
+    report("Account_pool clear 10M", sw.elapsed_ms(), "ms");
+}
+
+void print_sink_run(void)
+{
+    using namespace udemy1::s16c;
+
+    // every kind with balances that round in all the ways, the sink must write the same bytes
+    {
+        Account_pool pool;
+        const double odd[]{0.0, -0.0, 0.005, 0.015, 2.675, 1e-9, 1234567.895, 1e15 + 0.3, 1e300, -42.125};
+        for (int i{0}; i < 300; ++i) {
+            const std::string name{"Holder " + std::to_string(i)};
+            const double b{odd[i % 10] + i / 3};
+            switch (i % 3) {
+            case 0: pool.make<Checking>(name, b); break;
+            case 1: pool.make<Savings>(name, b, odd[i % 7] + 0.1 * i); break;
+            default: pool.make<Trust>(name, b, 1.5)->withdraw(i % 5); break;
+            }
+        }
+        std::ostringstream by_stream, by_sink;
+        for (const Account* acc : pool.accounts())
+            by_stream << *acc << std::endl;
+        by_stream << 1.0 / 3 << std::endl;
+        std::streambuf* const saved{std::cout.rdbuf(by_sink.rdbuf())};
+        std::vector<Account*> accs{pool.accounts()};
+        display(accs);
+        std::cout << 1.0 / 3 << std::endl;
+        std::cout.rdbuf(saved);
+        std::cout.precision(6);
+        std::cout.unsetf(std::ios::floatfield);
+        const std::string sink_text{by_sink.str()};
+        const bool same{sink_text.substr(sink_text.find('\n', 1) + 1) == by_stream.str()};
+        report("300 accounts, sink prints like the stream", same ? 1.0 : 0.0, same ? "(yes)" : "(NO)");
+    }
+
+    Account_pool pool;
+    pool.reserve(store_accounts, sizeof(Trust));
+    for (int i{0}; i < store_accounts; ++i) {
+        switch (i % 3) {
+        case 0: pool.make<Checking>("Checking", 1000.0 + i * 0.01); break;
+        case 1: pool.make<Savings>("Savings", 1000.0 + i * 0.01, 2.0); break;
+        default: pool.make<Trust>("Trust", 1000.0 + i * 0.01, 2.0); break;
+        }
+    }
+
+    std::ofstream devnull{"/dev/null"};
+    Stopwatch sw;
+    for (const Account* acc : pool.accounts())
+        devnull << *acc << std::endl;
+    const double endl_ms{sw.elapsed_ms()};
+    report("ostream << std::endl, 10M to /dev/null", endl_ms, "ms");
+
+    sw.reset();
+    for (const Account* acc : pool.accounts())
+        devnull << *acc << '\n';
+    devnull.flush();
+    report("ostream << '\\n', 10M to /dev/null", sw.elapsed_ms(), "ms");
+
+    const std::size_t allocs{alloc_count()};
+    sw.reset();
+    {
+        Print_sink out{devnull};
+        for (const Account* acc : pool.accounts())
+            out << *acc << '\n';
+    }
+    const double sink_ms{sw.elapsed_ms()};
+    const std::size_t sink_allocs{alloc_count() - allocs};
+    report("Print_sink, 10M to /dev/null", sink_ms, "ms");
+    report("Print_sink allocations", static_cast<double>(sink_allocs), "calls");
+    report("speedup over std::endl", endl_ms / sink_ms, "x");
+}
+
+void money_run(void)
+{
+    // balances up to $1M, rates up to 10% in steps of 0.001%
+    std::mt19937_64 rng{13};
+    std::vector<Money> balances(money_accounts);
+    std::vector<Rate> rates(money_accounts);
+    for (int i{0}; i < money_accounts; ++i) {
+        balances[i] = Money::from_units(static_cast<std::int64_t>(rng() % 100'000'000));
+        rates[i] = Rate::from_units(static_cast<std::int64_t>(rng() % 10'001) * 1'000);
+    }
+
+    // the last two come from accounts of the s15c classes
+    const s15c::Savings_Account savings{"Saver", 1234.56, 2.75};
+    const s15c::Trust_Account trust{"Trustee", 98765.43, 1.125};
+    balances[money_accounts - 2] = Money::from_double(savings.get_balance());
+    rates[money_accounts - 2] = Rate::from_percent(savings.get_int_rate());
+    balances[money_accounts - 1] = Money::from_double(trust.get_balance());
+    rates[money_accounts - 1] = Rate::from_percent(trust.get_int_rate());
+
+    // edge cases at the front: exact halves both ways, and products past 2^63
+    const std::int64_t half_rate{50 * Rate::scale};
+    const std::int64_t edges[][2]{{1, half_rate}, {-1, half_rate}, {3, half_rate}, {-3, half_rate},
+                                  {INT64_MAX / 4, Rate::scale}, {-(INT64_MAX / 4), Rate::scale},
+                                  {1'000'000'000'000'000, 5 * Rate::scale}};
+    for (std::size_t i{0}; i < std::size(edges); ++i) {
+        balances[i] = Money::from_units(edges[i][0]);
+        rates[i] = Rate::from_units(edges[i][1]);
+    }
+
+    // the reference, exact 128 bit interest one account at a time
+    std::vector<Money> expected{balances};
+    for (std::size_t i{0}; i < expected.size(); ++i)
+        expected[i] += interest(expected[i], rates[i]);
+
+    // before: the same columns as doubles, dollars and percent
+    std::vector<double> dollars(money_accounts), percent(money_accounts);
+    for (int i{0}; i < money_accounts; ++i) {
+        dollars[i] = balances[i].to_double();
+        percent[i] = rates[i].percent();
+    }
+    std::vector<double> rounded{dollars};
+
+    Stopwatch sw;
+    for (int p{0}; p < money_periods; ++p)
+        for (std::size_t i{0}; i < dollars.size(); ++i)
+            dollars[i] += dollars[i] * percent[i] / 100;
+    report("double loop, unrounded", sw.elapsed_ms() / money_periods, "ms/period");
+    keep(dollars);
+
+    sw.reset();
+    for (int p{0}; p < money_periods; ++p)
+        for (std::size_t i{0}; i < rounded.size(); ++i)
+            rounded[i] += std::round(rounded[i] * percent[i]) / 100;
+    report("double loop, rounded to cents", sw.elapsed_ms() / money_periods, "ms/period");
+
+    std::vector<Money> first;
+    for (int threads : {1, 2, 4}) {
+        std::vector<Money> accrued{balances};
+        accrue_interest(accrued, rates, threads);
+        const bool exact{accrued == expected};
+
+        sw.reset();
+        for (int p{1}; p < money_periods; ++p)
+            accrue_interest(accrued, rates, threads);
+        const double ms{sw.elapsed_ms() / (money_periods - 1)};
+        if (first.empty())
+            first = accrued;
+        const bool same{accrued == first};
+        report("accrue_interest, " + std::to_string(threads) + " thread(s)", ms,
+               std::string{"ms/period"} + (exact ? "" : ", NOT EXACT") + (same ? "" : ", DIFFERS FROM 1 THREAD"));
+    }
+
+    // how far the rounded doubles drift from the exact cents after a year
+    std::size_t drifted{0};
+    for (std::size_t i{std::size(edges)}; i < rounded.size(); ++i)
+        drifted += Money::from_double(rounded[i]) != first[i];
+    report("double accounts off by a cent or more", static_cast<double>(drifted), "accounts");
+}
+
+void ledger_run(void)
+{
+    using namespace udemy1::s15c;
+
+    // uniform: every account equally likely, hot: 9 postings in 10 go to account 0
+    const std::vector<Posting> uniform{make_postings(postings, ledger_accounts)};
+    std::vector<Posting> skewed{uniform};
+    for (std::size_t i{0}; i < skewed.size(); ++i)
+        if (i % 10 != 0)
+            skewed[i].account = 0;
+    const std::vector<Posting>& hot{skewed};
+
+    std::vector<Post_result> results;
+    for (const auto& [name, batch] : {std::pair{"uniform", &uniform}, std::pair{"hot account", &hot}}) {
+        // before: the single threaded engine, the accounts can not be shared
+        std::vector<Checking_Account> checking(ledger_accounts, Checking_Account{"Checking", 1000.0});
+        Stopwatch sw;
+        keep(post(checking, *batch, results));
+        report(std::string{name} + ", post on vector, 1 thread", postings / sw.elapsed_ms() / 1e3, "M postings/s");
+
+        for (int threads : {1, 2, 4, 8}) {
+            Ledger ledger;
+            for (int i{0}; i < ledger_accounts; ++i)
+                ledger.open(Kind::checking, Money::from_double(1000.0));
+            sw.reset();
+            post(ledger, *batch, results, threads);
+            const double ms{sw.elapsed_ms()};
+
+            // every accepted posting must show in the balances, and only those
+            long long expected{1000'00LL * ledger_accounts}, total{0};
+            for (std::size_t i{0}; i < batch->size(); ++i)
+                if (results[i] == Post_result::ok) {
+                    const long long cents{Money::from_double((*batch)[i].amount).units()};
+                    expected += (*batch)[i].op == Op::deposit ? cents : -(cents + 150);
+                }
+            bool negative{false};
+            for (std::uint32_t a{0}; a < ledger.size(); ++a) {
+                total += ledger.balance(a).units();
+                negative = negative || ledger.balance(a) < Money{};
+            }
+            const bool exact{total == expected && !negative};
+            report(std::string{name} + ", Ledger, " + std::to_string(threads) + " thread(s)", postings / ms / 1e3,
+                   exact ? "M postings/s" : "M postings/s, BALANCES WRONG");
+        }
+    }
+}
+
+void journal_run(void)
+{
+    using namespace udemy1::s15c;
+    const std::string path{"journal_bench"};
+    const auto remove_files = [&path] {
+        std::filesystem::remove(path + ".journal");
+        std::filesystem::remove(path + ".snapshot");
+    };
+    const std::vector<Posting> batch{make_postings(journal_ops, journal_accounts)};
+
+    for (const auto& [name, durability] : {std::pair{"none", Durability::none}, std::pair{"batched", Durability::batched},
+                                           std::pair{"per_op", Durability::per_op}}) {
+        const int ops{durability == Durability::per_op ? journal_synced_ops : journal_ops};
+        remove_files();
+        std::vector<std::int64_t> ns(ops);
+        std::size_t syncs{0};
+        double ms{0};
+        {
+            Journaled_ledger journal{path, durability, 64};
+            std::uint32_t account{0};
+            for (int i{0}; i < journal_accounts; ++i)
+                journal.open(Kind::checking, Money::from_double(1000.0), Rate{}, account);
+            journal.commit();
+
+            Stopwatch sw;
+            for (int i{0}; i < ops; ++i) {
+                const Posting& p{batch[i]};
+                const auto start{std::chrono::steady_clock::now()};
+                if (p.op == Op::deposit)
+                    journal.deposit(p.account, Money::from_double(p.amount));
+                else
+                    journal.withdraw(p.account, Money::from_double(p.amount));
+                ns[i] = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start)
+                            .count();
+            }
+            journal.commit();
+            ms = sw.elapsed_ms();
+            syncs = journal.syncs();
+        }
+        std::sort(ns.begin(), ns.end());
+        report(std::string{name} + ", 1 thread", ops / ms, "k ops/s");
+        report(std::string{name} + ", op latency p50", static_cast<double>(ns[ops / 2]), "ns");
+        report(std::string{name} + ", op latency p99", static_cast<double>(ns[ops * 99 / 100]), "ns");
+        report(std::string{name} + ", syncs", static_cast<double>(syncs), "");
+
+        Stopwatch sw;
+        Journaled_ledger recovered{path, durability};
+        report(std::string{name} + ", recovery", recovered.replayed() / sw.elapsed_ms() / 1e3,
+               recovered.replayed() == static_cast<std::size_t>(ops + journal_accounts) ? "M records/s"
+                                                                                      : "M records/s, RECORDS MISSING");
+    }
+
+    // per_op from several threads, the ones waiting on a sync share the next one
+    for (int threads : {2, 4, 8}) {
+        remove_files();
+        Journaled_ledger journal{path, Durability::per_op};
+        std::uint32_t account{0};
+        for (int i{0}; i < journal_accounts; ++i)
+            journal.open(Kind::checking, Money::from_double(1000.0), Rate{}, account);
+        const std::size_t before{journal.syncs()};
+
+        Stopwatch sw;
+        std::vector<std::thread> workers;
+        for (int t{0}; t < threads; ++t)
+            workers.emplace_back([&journal, &batch, t, threads] {
+                for (int i{t}; i < journal_synced_ops; i += threads)
+                    journal.deposit(batch[i].account, Money::from_double(batch[i].amount));
+            });
+        for (std::thread& worker : workers)
+            worker.join();
+        const double ms{sw.elapsed_ms()};
+        const std::size_t syncs{journal.syncs() - before};
+        report("per_op, " + std::to_string(threads) + " threads", journal_synced_ops / ms, "k ops/s");
+        report("per_op, " + std::to_string(threads) + " threads, ops per sync",
+               static_cast<double>(journal_synced_ops) / static_cast<double>(syncs), "");
+    }
+    remove_files();
+}
+
+} // namespace udemy1::bench
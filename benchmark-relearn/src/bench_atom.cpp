@@ -0,0 +1,124 @@
+/**
+ * Copyright © 2022 by Karthik Jain <krthkj.public@gmail.com>
+ * All Rights Reserved.
+ * Using MIT licence, refer the license file supplied with the project.
+ *
+ * File : bench_atom.cpp
+ * Desc : Memory and equality cost of Mystring against interned Atom handles,
+ *        on the words of the Romeo and Juliet text
+ *
+ * Author : Karthik Jain <krthkj.public@gmail.com>
+ * Date : 2026-10-17
+ *
+ */
+
+#include "atom_table.hpp"
+#include "mystring.hpp"
+#include "udemy1-benchmark.hpp"
+
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace udemy1::bench
+{
+using udemy1::myclass::Atom;
+using udemy1::myclass::Atom_table;
+using udemy1::myclass::Mystring;
+
+namespace
+{
+constexpr int copies{40}; // the play is ~26k words, repeat it to get a workload of ~1M keys
+
+std::vector<std::string> read_words(const std::string& file_name)
+{
+    std::vector<std::string> words;
+    std::ifstream ifs{file_name};
+    if (!ifs)
+        std::cerr << "File open error: " << file_name << std::endl;
+    std::string word;
+    while (ifs >> word)
+        words.push_back(word);
+    return words;
+}
+
+template <typename T>
+std::size_t count_equal_neighbours(const std::vector<T>& tokens)
+{
+    std::size_t equal{0};
+    for (std::size_t i{1}; i < tokens.size(); ++i)
+        equal += (tokens[i] == tokens[i - 1]);
+    return equal;
+}
+} // namespace
+
+void atom_run(void)
+{
+    const std::vector<std::string> words{read_words(data_file("romeoandjuliet_unix.txt"))};
+    if (words.empty())
+        return;
+    report("words in the play", static_cast<double>(words.size()), "");
+    report("copies of the play", copies, "");
+
+    // every token kept as its own Mystring
+    std::size_t heap_before{heap_in_use()};
+    std::vector<Mystring> strings;
+    strings.reserve(words.size() * copies);
+    for (int c{0}; c < copies; ++c)
+        for (const std::string& w : words)
+            strings.emplace_back(std::string_view{w});
+    const std::size_t string_bytes{heap_in_use() - heap_before};
+
+    // every token kept as an atom, the text is stored once in the table
+    heap_before = heap_in_use();
+    Atom_table table;
+    std::vector<Atom> atoms;
+    atoms.reserve(words.size() * copies);
+    Stopwatch sw;
+    for (int c{0}; c < copies; ++c)
+        for (const std::string& w : words)
+            atoms.push_back(table.intern(w));
+    const double intern_ms{sw.elapsed_ms()};
+    const std::size_t atom_bytes{heap_in_use() - heap_before};
+
+    report("distinct words (atoms)", static_cast<double>(table.size()), "");
+    report("vector<Mystring> heap", string_bytes / 1024.0, "KB");
+    report("vector<Atom> + Atom_table heap", atom_bytes / 1024.0, "KB");
+    report("memory saved", 100.0 * (1.0 - static_cast<double>(atom_bytes) / string_bytes), "%");
+    report("intern time", intern_ms * 1e6 / atoms.size(), "ns/word");
+
+    sw.reset();
+    std::size_t equal{count_equal_neighbours(strings)};
+    const double string_ms{sw.elapsed_ms()};
+    keep(equal);
+    sw.reset();
+    equal += count_equal_neighbours(atoms);
+    const double atom_ms{sw.elapsed_ms()};
+    keep(equal);
+    report("Mystring == over neighbours", string_ms * 1e6 / strings.size(), "ns/op");
+    report("Atom == over neighbours", atom_ms * 1e6 / atoms.size(), "ns/op");
+    report("equality speedup", string_ms / atom_ms, "x");
+
+    // several threads interning the same words must agree on every handle
+    std::vector<std::vector<Atom>> per_thread(4);
+    std::vector<std::thread> threads;
+    Atom_table shared;
+    sw.reset();
+    for (auto& out : per_thread)
+        threads.emplace_back([&words, &shared, &out] {
+            for (const std::string& w : words)
+                out.push_back(shared.intern(w));
+        });
+    for (auto& t : threads)
+        t.join();
+    const double shared_ms{sw.elapsed_ms()};
+    bool same{true};
+    for (const auto& out : per_thread)
+        same = same && (out == per_thread.front());
+    report("4 threads interning, handles agree", same ? 1.0 : 0.0, same ? "(yes)" : "(NO)");
+    report("4 threads interning time", shared_ms * 1e6 / (words.size() * per_thread.size()), "ns/word");
+}
+
+} // namespace udemy1::bench
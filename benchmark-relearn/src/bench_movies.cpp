@@ -0,0 +1,386 @@
+/**
+ * Copyright © 2022 by Karthik Jain <krthkj.public@gmail.com>
+ * All Rights Reserved.
+ * Using MIT licence, refer the license file supplied with the project.
+ *
+ * File : bench_movies.cpp
+ * Desc : Benchmarks for udemy1::s13c::Movies (section 13 challenge)
+ *
+ * Author : Karthik Jain <krthkj.public@gmail.com>
+ * Date : 2026-10-17
+ *
+ */
+
+#include "movie_table.hpp"
+#include "movies.hpp"
+#include "movies_file.hpp"
+#include "udemy1-benchmark.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace udemy1::bench
+{
+using udemy1::s13c::Movie;
+using udemy1::s13c::Movie_table;
+using udemy1::s13c::Movies;
+using udemy1::s13c::Movies_file;
+using udemy1::s13c::Watch_event;
+
+namespace
+{
+constexpr int titles{1'000'000};
+constexpr int increments{10'000'000};
+
+constexpr int batch_titles{100'000};
+constexpr int file_titles{10'000'000};
+constexpr int file_queries{1'000'000};
+constexpr int table_titles{1'000'000};
+constexpr int table_scans{20};
+constexpr int batch_events{4'000'000};
+
+const char* const ratings[]{"G", "PG", "PG-13", "R"};
+
+std::string make_title(int i)
+{
+    return "Feature presentation #" + std::to_string(i);
+}
+
+std::vector<std::string> make_titles(int n)
+{
+    std::vector<std::string> names;
+    names.reserve(n);
+    for (int i{0}; i < n; ++i)
+        names.push_back(make_title(i));
+    return names;
+}
+
+// what display() prints, the catalogs are compared through it
+template <typename Catalog>
+std::string listing(const Catalog& movies)
+{
+    std::ostringstream out;
+    std::streambuf* const saved{std::cout.rdbuf(out.rdbuf())};
+    movies.display();
+    std::cout.rdbuf(saved);
+    return out.str();
+}
+} // namespace
+
+void movies_run(void)
+{
+    const std::vector<std::string> names{make_titles(titles)};
+
+    Movies movies;
+    Stopwatch sw;
+    int added{0};
+    for (int i{0}; i < titles; ++i)
+        added += movies.add_movie(names[i], ratings[i % 4], 0);
+    double ms{sw.elapsed_ms()};
+    report("add_movie, 1M new titles", ms * 1e6 / titles, "ns/op");
+    report("add_movie, 1M new titles total", ms, "ms");
+
+    sw.reset();
+    for (int i{0}; i < titles; i += 10)
+        added -= movies.add_movie(names[i], "G", 0);
+    ms = sw.elapsed_ms();
+    keep(added);
+    report("add_movie, duplicate titles", ms * 1e6 / (titles / 10), "ns/op");
+
+    // titles picked by a fixed LCG so every run increments the same movies
+    std::uint32_t seed{12345};
+    int found{0};
+    sw.reset();
+    for (int i{0}; i < increments; ++i) {
+        seed = seed * 1664525u + 1013904223u;
+        found += movies.increment_watched(names[seed % titles]);
+    }
+    ms = sw.elapsed_ms();
+    keep(found);
+    report("increment_watched, 10M hits", ms * 1e6 / increments, "ns/op");
+    report("increment_watched, 10M hits total", ms, "ms");
+
+    sw.reset();
+    for (int i{0}; i < titles; i += 10)
+        found += movies.increment_watched("Unreleased #" + std::to_string(i));
+    ms = sw.elapsed_ms();
+    keep(found);
+    report("increment_watched, unknown titles", ms * 1e6 / (titles / 10), "ns/op");
+}
+
+void movies_batch_run(void)
+{
+    const std::vector<std::string> names{make_titles(batch_titles)};
+
+    // a stream of viewing events, about 1 in 20 names is not in the catalog
+    std::vector<std::string> unknown;
+    for (int i{0}; i < batch_titles / 20; ++i)
+        unknown.push_back("Unreleased #" + std::to_string(i));
+
+    std::vector<Watch_event> events;
+    events.reserve(batch_events);
+    std::uint32_t seed{12345};
+    for (int i{0}; i < batch_events; ++i) {
+        seed = seed * 1664525u + 1013904223u;
+        if (seed % 20 == 0)
+            events.push_back({unknown[(seed >> 8) % unknown.size()], 1});
+        else
+            events.push_back({names[(seed >> 8) % batch_titles], static_cast<int>(seed >> 29) + 1});
+    }
+
+    const auto load = [&names] {
+        Movies movies;
+        for (int i{0}; i < batch_titles; ++i)
+            movies.add_movie(names[i], ratings[i % 4], 0);
+        return movies;
+    };
+
+    // before: one increment_watched call, with a std::string copy, per watch
+    Movies one_by_one{load()};
+    std::size_t calls{0};
+    Stopwatch sw;
+    for (const Watch_event& e : events)
+        for (int c{0}; c < e.count; ++c, ++calls)
+            one_by_one.increment_watched(std::string{e.name});
+    double ms{sw.elapsed_ms()};
+    report("increment_watched per watch", events.size() / ms / 1e3, "M events/s");
+    report("increment_watched calls", static_cast<double>(calls), "");
+    const std::string expected{listing(one_by_one)};
+
+    for (int threads : {1, 2, 4, 8}) {
+        Movies batched{load()};
+        sw.reset();
+        const std::size_t applied{batched.add_watched(events, threads)};
+        ms = sw.elapsed_ms();
+        keep(applied);
+        const bool same{listing(batched) == expected};
+        report("add_watched, " + std::to_string(threads) + " threads", events.size() / ms / 1e3,
+               same ? "M events/s" : "M events/s, WRONG COUNTS");
+    }
+
+    // a batch far smaller than the catalog, its cost follows the batch
+    const std::span<const Watch_event> few{events.data(), 1000};
+    Movies one_each{load()};
+    for (const Watch_event& e : few)
+        for (int c{0}; c < e.count; ++c)
+            one_each.increment_watched(std::string{e.name});
+    Movies small_batch{load()};
+    sw.reset();
+    keep(small_batch.add_watched(few, 8));
+    ms = sw.elapsed_ms();
+    report("add_watched, 1000 events, 8 threads", ms * 1e3,
+           listing(small_batch) == listing(one_each) ? "us" : "us, WRONG COUNTS");
+
+    // counts past INT_MAX stop there instead of wrapping
+    Movies busy;
+    busy.add_movie(names[0], ratings[0], std::numeric_limits<int>::max() - 1);
+    const std::vector<Watch_event> more(3, Watch_event{names[0], std::numeric_limits<int>::max()});
+    busy.add_watched(more, 1);
+    const bool capped{listing(busy).find(std::to_string(std::numeric_limits<int>::max())) != std::string::npos};
+    report("add_watched saturates at INT_MAX", capped ? 1.0 : 0.0, capped ? "(yes)" : "(NO)");
+}
+
+void movies_file_run(void)
+{
+    const std::filesystem::path dir{std::filesystem::temp_directory_path()};
+    const std::string csv_name{(dir / "udemy1-bench-movies.csv").string()};
+    const std::string file_name{(dir / "udemy1-bench-movies.bin").string()};
+
+    // a small catalog first, the file must display and count exactly like Movies
+    {
+        Movies movies;
+        for (int i{0}; i < 1000; ++i)
+            movies.add_movie(make_title(i), ratings[i % 4], i % 7);
+        movies.save(file_name);
+        Movies_file file{file_name};
+        for (int i{0}; i < 1000; i += 3) {
+            movies.increment_watched(make_title(i));
+            file.increment_watched(make_title(i));
+        }
+        const bool same{listing(movies) == listing(file)};
+        report("1k catalog, file displays like Movies", same ? 1.0 : 0.0, same ? "(yes)" : "(NO)");
+    }
+
+    // a damaged index with no empty slot, a name not in it is still not found
+    {
+        std::uint64_t bucket_count{0}, index_offset{0}; // of the Header, at 16 and 32
+        std::fstream f{file_name, std::ios::binary | std::ios::in | std::ios::out};
+        f.seekg(16);
+        f.read(reinterpret_cast<char*>(&bucket_count), sizeof bucket_count);
+        f.seekg(32);
+        f.read(reinterpret_cast<char*>(&index_offset), sizeof index_offset);
+        const std::uint32_t full_slot[2]{1, 0};
+        f.seekp(static_cast<std::streamoff>(index_offset));
+        for (std::uint64_t b{0}; b < bucket_count; ++b)
+            f.write(reinterpret_cast<const char*>(full_slot), sizeof full_slot);
+        f.close();
+        Movies_file file{file_name};
+        int watched{0};
+        const bool stops{file.is_open() && !file.get_watched("not a movie", watched)};
+        report("index with no empty slot, lookup stops", stops ? 1.0 : 0.0, stops ? "(yes)" : "(NO)");
+    }
+
+    // today's startup: every movie is added again
+    Stopwatch sw;
+    {
+        Movies movies;
+        for (int i{0}; i < file_titles; ++i)
+            movies.add_movie(make_title(i), ratings[i % 4], i % 7);
+        report("10M titles, add_movie startup", sw.elapsed_ms(), "ms");
+    }
+
+    {
+        std::ofstream csv{csv_name};
+        csv << "name,rating,watched\n";
+        for (int i{0}; i < file_titles; ++i)
+            csv << make_title(i) << ',' << ratings[i % 4] << ',' << i % 7 << '\n';
+    }
+    sw.reset();
+    const bool converted{udemy1::s13c::csv_to_movies_file(csv_name, file_name)};
+    report("10M titles, CSV to catalog file", sw.elapsed_ms(), converted ? "ms" : "ms, FAILED");
+    report("catalog file size", std::filesystem::file_size(file_name) / 1048576.0, "MB");
+    std::filesystem::remove(csv_name);
+
+    sw.reset();
+    Movies_file file{file_name};
+    report("10M titles, Movies_file startup", sw.elapsed_ms(), "ms");
+    report("movies in the file", static_cast<double>(file.size()), "");
+
+    std::uint32_t seed{12345};
+    int found{0};
+    sw.reset();
+    for (int i{0}; i < file_queries; ++i) {
+        seed = seed * 1664525u + 1013904223u;
+        found += file.increment_watched(make_title(seed % file_titles));
+    }
+    const double ms{sw.elapsed_ms()};
+    report("increment_watched in the file", ms * 1e6 / file_queries, "ns/op");
+    report("increment_watched hits", found, "");
+    std::filesystem::remove(file_name);
+}
+
+void movie_table_run(void)
+{
+    const std::vector<std::string> names{make_titles(table_titles)};
+    std::vector<int> rating_of(table_titles), watched_of(table_titles);
+    std::uint32_t seed{12345};
+    for (int i{0}; i < table_titles; ++i) {
+        seed = seed * 1664525u + 1013904223u;
+        rating_of[i] = static_cast<int>(seed >> 30);
+        watched_of[i] = static_cast<int>((seed >> 8) % 100'000);
+    }
+
+    // a small catalog first, the table must display and count exactly like Movies
+    {
+        Movies movies;
+        Movie_table table;
+        for (int i{0}; i < 1000; ++i) {
+            movies.add_movie(names[i], ratings[rating_of[i]], watched_of[i]);
+            table.add_movie(names[i], ratings[rating_of[i]], watched_of[i]);
+        }
+        for (int i{0}; i < 1000; i += 3) {
+            movies.increment_watched(names[i]);
+            table.increment_watched(names[i]);
+        }
+        const bool same{listing(movies) == listing(table)};
+        report("1k catalog, table displays like Movies", same ? 1.0 : 0.0, same ? "(yes)" : "(NO)");
+    }
+
+    // before: the records as Movie objects, the way Movies stores them
+    std::size_t heap_before{heap_in_use()};
+    std::vector<Movie> records;
+    for (int i{0}; i < table_titles; ++i)
+        records.emplace_back(names[i], ratings[rating_of[i]], watched_of[i]);
+    report("vector<Movie> heap", (heap_in_use() - heap_before) / 1048576.0, "MB");
+
+    heap_before = heap_in_use();
+    Movie_table table;
+    Stopwatch sw;
+    for (int i{0}; i < table_titles; ++i)
+        table.add_movie(names[i], ratings[rating_of[i]], watched_of[i]);
+    report("Movie_table add_movie", sw.elapsed_ms() * 1e6 / table_titles, "ns/op");
+    report("Movie_table heap (with name index)", (heap_in_use() - heap_before) / 1048576.0, "MB");
+
+    sw.reset();
+    for (int i{0}; i < table_titles; ++i)
+        table.increment_watched(names[(i * 7919ull) % table_titles]);
+    report("Movie_table increment_watched", sw.elapsed_ms() * 1e6 / table_titles, "ns/op");
+    for (int i{0}; i < table_titles; ++i)
+        records[(i * 7919ull) % table_titles].increment_watched();
+
+    long long sum{0};
+    sw.reset();
+    for (int n{0}; n < table_scans; ++n)
+        for (const Movie& m : records)
+            if (m.getRating() == "R")
+                sum += m.getWatched();
+    double ms{sw.elapsed_ms()};
+    keep(sum);
+    report("sum watched of R, vector<Movie>", ms / table_scans, "ms/scan");
+
+    long long table_sum{0};
+    sw.reset();
+    for (int n{0}; n < table_scans; ++n)
+        table_sum += table.total_watched("R");
+    ms = sw.elapsed_ms();
+    keep(table_sum);
+    report("sum watched of R, Movie_table", ms / table_scans, sum == table_sum ? "ms/scan" : "ms/scan, WRONG SUM");
+
+    sw.reset();
+    std::vector<std::pair<std::string, long long>> by_rating;
+    for (int n{0}; n < table_scans; ++n) {
+        by_rating.clear();
+        for (const Movie& m : records) {
+            auto found{std::find_if(by_rating.begin(), by_rating.end(),
+                                    [&m](const auto& total) { return total.first == m.getRating(); })};
+            if (found == by_rating.end())
+                found = by_rating.insert(by_rating.end(), {m.getRating(), 0});
+            found->second += m.getWatched();
+        }
+    }
+    ms = sw.elapsed_ms();
+    report("watched by rating, vector<Movie>", ms / table_scans, "ms/scan");
+
+    sw.reset();
+    std::vector<std::pair<std::string, long long>> table_by_rating;
+    for (int n{0}; n < table_scans; ++n)
+        table_by_rating = table.watched_by_rating();
+    ms = sw.elapsed_ms();
+    report("watched by rating, Movie_table", ms / table_scans,
+           by_rating == table_by_rating ? "ms/scan" : "ms/scan, WRONG TOTALS");
+
+    constexpr std::size_t k{10};
+    std::vector<std::size_t> top;
+    sw.reset();
+    for (int n{0}; n < table_scans; ++n) {
+        top.clear();
+        for (std::size_t i{0}; i < records.size(); ++i)
+            if (records[i].getRating() == "PG-13")
+                top.push_back(i);
+        std::partial_sort(top.begin(), top.begin() + k, top.end(), [&records](std::size_t a, std::size_t b) {
+            return records[a].getWatched() > records[b].getWatched() ||
+                   (records[a].getWatched() == records[b].getWatched() && a < b);
+        });
+    }
+    ms = sw.elapsed_ms();
+    report("top 10 of PG-13, vector<Movie>", ms / table_scans, "ms/scan");
+
+    std::vector<udemy1::s13c::Movie_row> table_top;
+    sw.reset();
+    for (int n{0}; n < table_scans; ++n)
+        table_top = table.top_watched(k, "PG-13");
+    ms = sw.elapsed_ms();
+    bool same{table_top.size() == k};
+    for (std::size_t i{0}; same && i < k; ++i)
+        same = table_top[i].name == records[top[i]].getName();
+    report("top 10 of PG-13, Movie_table", ms / table_scans, same ? "ms/scan" : "ms/scan, WRONG MOVIES");
+}
+
+} // namespace udemy1::bench
@@ -0,0 +1,210 @@
+/**
+ * Copyright © 2022 by Karthik Jain <krthkj.public@gmail.com>
+ * All Rights Reserved.
+ * Using MIT licence, refer the license file supplied with the project.
+ *
+ * File : bench_mystring.cpp
+ * Desc : Benchmarks for udemy1::myclass::Mystring (section 14 challenge)
+ *
+ * Author : Karthik Jain <krthkj.public@gmail.com>
+ * Date : 2026-10-17
+ *
+ */
+
+#include "mystring.hpp"
+#include "udemy1-benchmark.hpp"
+
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace udemy1::bench
+{
+using udemy1::myclass::Mystring;
+
+namespace
+{
+constexpr int iterations{1'000'000};
+
+const char* const short_key{"account_0042"};                              // fits in the small buffer
+const char* const long_key{"a rather long key that needs the heap 0042"}; // does not
+
+/**
+ * @brief Run op() 'iterations' times and report the allocations per call and time per call
+ */
+template <typename Op>
+void measure(const std::string& name, Op op)
+{
+    const std::size_t allocs_before{alloc_count()};
+    Stopwatch sw;
+    for (int i{0}; i < iterations; ++i)
+        op();
+    const double ms{sw.elapsed_ms()};
+    const std::size_t allocs{alloc_count() - allocs_before};
+
+    report(name + " allocs", static_cast<double>(allocs) / iterations, "/op");
+    report(name + " time", ms * 1e6 / iterations, "ns/op");
+}
+} // namespace
+
+void mystring_run(void)
+{
+    const Mystring short_src{short_key};
+    const Mystring long_src{long_key};
+
+    measure("construct default", [] {
+        Mystring s;
+        keep(s);
+    });
+    measure("construct short", [] {
+        Mystring s{short_key};
+        keep(s);
+    });
+    measure("construct long", [] {
+        Mystring s{long_key};
+        keep(s);
+    });
+    measure("copy short", [&] {
+        Mystring s{short_src};
+        keep(s);
+    });
+    measure("copy long", [&] {
+        Mystring s{long_src};
+        keep(s);
+    });
+
+    Mystring target{short_key};
+    measure("copy assign short", [&] {
+        target = short_src;
+        keep(target);
+    });
+
+    const Mystring prefix{"acc_"};
+    const Mystring suffix{"0042"};
+    measure("concat short + short", [&] {
+        Mystring s{prefix + suffix};
+        keep(s);
+    });
+    measure("concat long + short", [&] {
+        Mystring s{long_src + suffix};
+        keep(s);
+    });
+
+    long total{0};
+    measure("getLength long", [&] {
+        total += long_src.getLength();
+        keep(total);
+    });
+}
+
+void mystring_growth_run(void)
+{
+    // 1 KB unit string repeated n times, the time per repetition should stay flat as n grows
+    const std::string kb(1024, 'x');
+    const Mystring unit{kb.c_str()};
+
+    for (int n : {1'000, 2'500, 5'000, 10'000}) {
+        const std::string tag{" x" + std::to_string(n)};
+
+        std::size_t allocs_before{alloc_count()};
+        Stopwatch sw;
+        Mystring product{unit * n};
+        double ms{sw.elapsed_ms()};
+        keep(product);
+        report("operator*" + tag + " allocs", static_cast<double>(alloc_count() - allocs_before), "");
+        report("operator*" + tag + " time", ms * 1e6 / n, "ns/rep");
+
+        Mystring repeated{unit};
+        allocs_before = alloc_count();
+        sw.reset();
+        repeated *= n;
+        ms = sw.elapsed_ms();
+        keep(repeated);
+        report("operator*=" + tag + " allocs", static_cast<double>(alloc_count() - allocs_before), "");
+        report("operator*=" + tag + " time", ms * 1e6 / n, "ns/rep");
+
+        Mystring appended;
+        allocs_before = alloc_count();
+        sw.reset();
+        for (int i{0}; i < n; ++i)
+            appended += unit;
+        ms = sw.elapsed_ms();
+        keep(appended);
+        report("operator+=" + tag + " allocs", static_cast<double>(alloc_count() - allocs_before), "");
+        report("operator+=" + tag + " time", ms * 1e6 / n, "ns/rep");
+    }
+
+    const Mystring a{"a rather long key that needs the heap, part one"};
+    const Mystring b{"a rather long key that needs the heap, part two"};
+    const Mystring c{"a rather long key that needs the heap, part three"};
+    measure("chained a + b + c", [&] {
+        Mystring s{a + b + c};
+        keep(s);
+    });
+    measure("Mystring::concat(a, b, c)", [&] {
+        Mystring s{Mystring::concat(a, b, c)};
+        keep(s);
+    });
+}
+
+void mystring_map_run(void)
+{
+    constexpr int keys{100'000};
+    constexpr int lookups{2'000'000};
+
+    std::vector<Mystring> names;
+    std::vector<std::string> probes; // the text lookups arrive as, ex.) a parsed input line
+    for (int i{0}; i < keys; ++i) {
+        probes.push_back("account-holder-" + std::to_string(i * 7919));
+        names.emplace_back(std::string_view{probes.back()});
+    }
+
+    // before: the map is keyed by std::string, every Mystring is copied out to look it up
+    std::unordered_map<std::string, int> by_string;
+    for (int i{0}; i < keys; ++i)
+        by_string.emplace(names[i].getStr(), i);
+
+    long found{0};
+    std::size_t allocs_before{alloc_count()};
+    Stopwatch sw;
+    for (int i{0}; i < lookups; ++i)
+        found += by_string.find(std::string{names[i % keys].getStr()})->second;
+    double ms{sw.elapsed_ms()};
+    keep(found);
+    report("std::string map, copy Mystring allocs", static_cast<double>(alloc_count() - allocs_before) / lookups,
+           "/op");
+    report("std::string map, copy Mystring time", ms * 1e6 / lookups, "ns/op");
+
+    // after: keyed by Mystring, probed with a string_view
+    std::unordered_map<Mystring, int> by_mystring;
+    for (int i{0}; i < keys; ++i)
+        by_mystring.emplace(names[i], i);
+
+    found = 0;
+    allocs_before = alloc_count();
+    sw.reset();
+    for (int i{0}; i < lookups; ++i)
+        found += by_mystring.find(std::string_view{probes[i % keys]})->second;
+    ms = sw.elapsed_ms();
+    keep(found);
+    report("Mystring map, string_view probe allocs", static_cast<double>(alloc_count() - allocs_before) / lookups,
+           "/op");
+    report("Mystring map, string_view probe time", ms * 1e6 / lookups, "ns/op");
+
+    std::size_t h{0};
+    sw.reset();
+    for (int i{0}; i < lookups; ++i)
+        h += std::hash<std::string_view>{}(probes[i % keys]);
+    keep(h);
+    report("std::hash<string_view>", sw.elapsed_ms() * 1e6 / lookups, "ns/op");
+
+    sw.reset();
+    for (int i{0}; i < lookups; ++i)
+        h += Mystring::hash(probes[i % keys]);
+    keep(h);
+    report("Mystring::hash", sw.elapsed_ms() * 1e6 / lookups, "ns/op");
+}
+
+} // namespace udemy1::bench
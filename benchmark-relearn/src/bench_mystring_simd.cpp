@@ -0,0 +1,128 @@
+/**
+ * Copyright © 2022 by Karthik Jain <krthkj.public@gmail.com>
+ * All Rights Reserved.
+ * Using MIT licence, refer the license file supplied with the project.
+ *
+ * File : bench_mystring_simd.cpp
+ * Desc : Scalar vs SSE2 vs AVX2 kernels behind Mystring case folding and comparison
+ *
+ * Author : Karthik Jain <krthkj.public@gmail.com>
+ * Date : 2026-10-17
+ *
+ */
+
+#include "mystring.hpp"
+#include "mystring_simd.hpp"
+#include "udemy1-benchmark.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace udemy1::bench
+{
+using udemy1::myclass::Mystring;
+namespace simd = udemy1::myclass::simd;
+
+namespace
+{
+constexpr std::size_t buffer_size{1 << 20}; // 1 MB
+constexpr int buffer_rounds{200};
+
+std::vector<Mystring> make_keys(std::size_t count)
+{
+    // keys share a prefix like real world ids do, so comparisons have to look past it
+    std::mt19937 gen{42};
+    std::uniform_int_distribution<int> length{8, 48};
+    std::uniform_int_distribution<int> letter{'a', 'z'};
+
+    std::vector<Mystring> keys;
+    keys.reserve(count);
+    std::string key;
+    for (std::size_t i{0}; i < count; ++i) {
+        key = "customer/";
+        for (int n{length(gen)}; n > 0; --n)
+            key += static_cast<char>(letter(gen));
+        keys.emplace_back(key.c_str());
+    }
+    return keys;
+}
+} // namespace
+
+void mystring_simd_run(void)
+{
+    std::cout << "  best level on this cpu: " << simd::level_name(simd::best_level()) << std::endl;
+
+    std::string text(buffer_size, ' ');
+    std::mt19937 gen{7};
+    std::uniform_int_distribution<int> printable{32, 126};
+    for (char& c : text)
+        c = static_cast<char>(printable(gen));
+    std::string other{text};
+
+    for (simd::Level level : {simd::Level::scalar, simd::Level::sse2, simd::Level::avx2}) {
+        if (level > simd::best_level())
+            continue;
+        const std::string name{simd::level_name(level)};
+
+        Stopwatch sw;
+        for (int i{0}; i < buffer_rounds; ++i)
+            simd::flip_case(text.data(), text.size(), (i % 2) ? 'a' : 'A', level);
+        double ms{sw.elapsed_ms()};
+        keep(text);
+        report("flip_case 1 MB " + name, buffer_rounds * (buffer_size / 1e9) / (ms / 1e3), "GB/s");
+
+        int result{0};
+        sw.reset();
+        for (int i{0}; i < buffer_rounds; ++i)
+            result += simd::compare(text.data(), text.size(), other.data(), other.size(), level);
+        ms = sw.elapsed_ms();
+        keep(result);
+        other = text; // equal buffers, the whole MB is scanned
+        sw.reset();
+        for (int i{0}; i < buffer_rounds; ++i)
+            result += simd::compare(text.data(), text.size(), other.data(), other.size(), level);
+        ms = sw.elapsed_ms();
+        keep(result);
+        report("compare 1 MB equal " + name, buffer_rounds * (buffer_size / 1e9) / (ms / 1e3), "GB/s");
+    }
+
+    // sorting 1M keys, strcmp (the old operator<) against the new length aware kernel
+    const std::vector<Mystring> keys{make_keys(1'000'000)};
+
+    std::vector<Mystring> sorted{keys};
+    Stopwatch sw;
+    std::sort(sorted.begin(), sorted.end(),
+              [](const Mystring& a, const Mystring& b) { return std::strcmp(a.getStr(), b.getStr()) < 0; });
+    report("sort 1M Mystring, strcmp", sw.elapsed_ms(), "ms");
+
+    sorted = keys;
+    sw.reset();
+    std::sort(sorted.begin(), sorted.end());
+    report("sort 1M Mystring, operator<", sw.elapsed_ms(), "ms");
+
+    std::size_t equal{0};
+    sw.reset();
+    for (std::size_t i{1}; i < sorted.size(); ++i)
+        equal += (std::strcmp(sorted[i].getStr(), sorted[i - 1].getStr()) == 0);
+    keep(equal);
+    report("strcmp == over 1M neighbours", sw.elapsed_ms(), "ms");
+
+    sw.reset();
+    for (std::size_t i{1}; i < sorted.size(); ++i)
+        equal += (sorted[i] == sorted[i - 1]);
+    keep(equal);
+    report("operator== over 1M neighbours", sw.elapsed_ms(), "ms");
+
+    sw.reset();
+    for (const Mystring& key : keys) {
+        Mystring lower{-key};
+        keep(lower);
+    }
+    report("operator- over 1M keys", sw.elapsed_ms(), "ms");
+}
+
+} // namespace udemy1::bench
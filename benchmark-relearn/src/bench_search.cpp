@@ -0,0 +1,657 @@
+/**
+ * Copyright © 2023 by Karthik Jain <krthkj.public@gmail.com>
+ * All Rights Reserved.
+ * Using MIT licence, refer the license file supplied with the project.
+ *
+ * File : bench_search.cpp
+ * Desc : Benchmarks for the word search and word count challenges (sections 19 and 20)
+ *
+ * Author : Karthik Jain <krthkj.public@gmail.com>
+ * Date : 2026-10-18
+ *
+ */
+
+#include "mapped_file.hpp"
+#include "s19c3_keywords.hpp"
+#include "s19c3_search.hpp"
+#include "s20c3_count.hpp"
+#include "s20c3_index.hpp"
+#include "udemy1-benchmark.hpp"
+
+#include <algorithm>
+#include <fcntl.h>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <omp.h>
+#include <random>
+#include <set>
+#include <sstream>
+#include <string>
+#include <unistd.h>
+#include <utility>
+#include <vector>
+
+namespace udemy1::bench
+{
+
+namespace
+{
+constexpr std::size_t megabyte{std::size_t{1} << 20};
+constexpr std::size_t stream_corpus_mb{256};
+constexpr std::size_t mapped_corpus_mb{1024};
+constexpr std::size_t parallel_corpus_mb{2048};
+constexpr int most_threads{16};
+constexpr std::size_t keyword_corpus_mb{256};
+constexpr std::size_t count_map_corpus_mb{64}; // the std::map part1 is a few MiB/s
+constexpr std::size_t count_corpus_mb{1024};
+constexpr std::size_t index_corpus_mb{512}; // part2 keeps every (word, line), 1 GiB would take GiBs of them
+
+std::string read_file(const std::string& file_name)
+{
+    std::ifstream ifs{file_name, std::ios::binary};
+    return {std::istreambuf_iterator<char>{ifs}, std::istreambuf_iterator<char>{}};
+}
+
+/**
+ * @brief the play copied over and over into a file of about mb MiB in the temp directory,
+ *        written once and kept for the next runs
+ */
+std::string corpus_file(std::size_t mb)
+{
+    const std::filesystem::path path{std::filesystem::temp_directory_path() /
+                                     ("udemy1_corpus_" + std::to_string(mb) + "mb.txt")};
+    const std::string play{read_file(data_file("romeoandjuliet_unix.txt"))};
+    const std::size_t copies{(mb * megabyte + play.size() - 1) / play.size()};
+    std::error_code ec;
+    if (play.empty() || std::filesystem::file_size(path, ec) != copies * play.size()) {
+        std::ofstream ofs{path, std::ios::binary | std::ios::trunc};
+        for (std::size_t c{0}; c < copies; ++c)
+            ofs.write(play.data(), static_cast<std::streamsize>(play.size()));
+    }
+    return path.string();
+}
+
+// what the original loop counts, on a string
+s19c3::Word_count count_by_stream(const std::string& text, const std::string& target)
+{
+    std::istringstream iss{text};
+    s19c3::Word_count count{0, 0};
+    std::string word;
+    while (iss >> word) {
+        ++count.words;
+        count.matches += word.find(target) != std::string::npos;
+    }
+    return count;
+}
+
+/**
+ * @brief n distinct keywords: the words of the play in the order they first appear, then
+ *        the pieces of 3 to 12 bytes of those words, then pairs of words
+ */
+std::vector<std::string> make_keywords(std::size_t n)
+{
+    std::istringstream play{read_file(data_file("romeoandjuliet_unix.txt"))};
+    std::vector<std::string> words;
+    std::set<std::string> seen;
+    for (std::string w; play >> w;)
+        if (seen.insert(w).second)
+            words.push_back(w);
+
+    std::vector<std::string> keywords;
+    for (std::size_t i{0}; i < words.size() && keywords.size() < n; ++i)
+        keywords.push_back(words[i]);
+    for (std::size_t length{3}; length <= 12 && keywords.size() < n; ++length)
+        for (std::size_t i{0}; i < words.size() && keywords.size() < n; ++i)
+            for (std::size_t at{0}; at + length <= words[i].size() && keywords.size() < n; ++at)
+                if (seen.insert(words[i].substr(at, length)).second)
+                    keywords.push_back(words[i].substr(at, length));
+    for (std::size_t i{0}; keywords.size() < n && i < words.size() * words.size(); ++i) {
+        std::string pair{words[i % words.size()] + words[i / words.size()]}; // two words run together
+        if (seen.insert(pair).second)
+            keywords.push_back(std::move(pair));
+    }
+    return keywords;
+}
+
+template <typename Fn>
+int quietly(Fn fn)
+{
+    std::ostringstream sink;
+    std::streambuf* const saved{std::cout.rdbuf(sink.rdbuf())};
+    const int result{fn()};
+    std::cout.rdbuf(saved);
+    return result;
+}
+
+// the std::map<std::string, std::set<int>> that part2 builds, read the way part2 reads it
+std::map<std::string, std::set<int>> map_of_lines(const std::string& file_name)
+{
+    std::map<std::string, std::set<int>> words;
+    std::ifstream in_file{file_name};
+    std::stringstream ss;
+    std::string line, word;
+    unsigned int line_no{0};
+    while (std::getline(in_file, line)) {
+        ++line_no;
+        ss.str(line);
+        while (ss >> word)
+            words[s20c3::clean_string(word)].insert(line_no);
+        ss.clear();
+    }
+    return words;
+}
+
+// drop the pages of a file from the page cache, the next read of them goes to the disk
+void evict(const std::string& file_name)
+{
+    const int fd{::open(file_name.c_str(), O_RDONLY)};
+    if (fd < 0)
+        return;
+    ::fdatasync(fd);
+    ::posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+    ::close(fd);
+}
+
+// what fn writes to std::cout, the flags std::cout is left with are put back
+template <typename Fn>
+std::string printed(Fn fn)
+{
+    std::ostringstream out;
+    std::streambuf* const saved{std::cout.rdbuf(out.rdbuf())};
+    const std::ios::fmtflags flags{std::cout.flags()};
+    fn();
+    std::cout.flags(flags);
+    std::cout.rdbuf(saved);
+    return out.str();
+}
+} // namespace
+
+void s19c3_search_run(void)
+{
+    // the counts must be those of the >> loop, whatever the whitespace and the target
+    std::string tricky{read_file(data_file("romeoandjuliet_unix.txt"))};
+    tricky += " \t\v\f\r\n lovelovelove belove\xE2\x80\x99" "d \xFF" "love\xFF loveloveXlove lo ve l";
+    tricky += std::string(1000, 'a') + "love" + std::string(100, ' ') + "\tlove";
+    bool same{true};
+    for (const std::string target :
+         {"love", "Romeo", "Juliet", "Frank", "", "e", "l", "lo", "love\xFF", "lo ve", "aaaa", "\xE2\x80\x99", "\n"})
+        for (std::size_t cut : {tricky.size(), tricky.size() - 1, tricky.size() - 5, std::size_t{31}, std::size_t{0}}) {
+            const std::string text{tricky.substr(0, cut)};
+            const s19c3::Word_count expected{count_by_stream(text, target)};
+            const s19c3::Word_count got{s19c3::count_words(text, target)};
+            same = same && expected.words == got.words && expected.matches == got.matches;
+        }
+    report("counts same as the >> loop", same ? 1.0 : 0.0, same ? "(yes)" : "(NO)");
+
+    const std::string play{data_file("romeoandjuliet_unix.txt")};
+    for (const std::string target : {"love", "Romeo", "Juliet", "Frank"}) {
+        const int by_stream{quietly([&] { return s19c3::find_word_count(play, target); })};
+        const int mapped{quietly([&] { return s19c3::find_word_count_mapped(play, target); })};
+        report("play, " + target + " found", mapped, mapped == by_stream ? "times" : "times, NOT THE SAME");
+    }
+
+    // the corpus is in the page cache after it is written, this is the scan without the disk
+    const std::string small{corpus_file(stream_corpus_mb)};
+    Stopwatch sw;
+    const int by_stream{quietly([&] { return s19c3::find_word_count(small, "love"); })};
+    double ms{sw.elapsed_ms()};
+    report("find_word_count, 256 MiB", static_cast<double>(stream_corpus_mb) / (ms / 1000), "MiB/s");
+
+    sw.reset();
+    const int mapped{quietly([&] { return s19c3::find_word_count_mapped(small, "love"); })};
+    ms = sw.elapsed_ms();
+    report("find_word_count_mapped, 256 MiB", static_cast<double>(stream_corpus_mb) / (ms / 1000),
+           mapped == by_stream ? "MiB/s" : "MiB/s, NOT THE SAME");
+
+    const Mapped_file big{corpus_file(mapped_corpus_mb)};
+    for (const std::string target : {"love", "e", "Juliet", "Frank"}) {
+        sw.reset();
+        const s19c3::Word_count count{s19c3::count_words(big.text(), target)};
+        ms = sw.elapsed_ms();
+        keep(count.matches);
+        report("count_words 1 GiB, " + target, static_cast<double>(big.text().size()) / megabyte / (ms / 1000),
+               "MiB/s");
+    }
+}
+
+void s19c3_parallel_run(void)
+{
+    // cuts that land inside words, one of them several pieces long, must not change the counts
+    std::string text;
+    for (int i{0}; i < 200'000; ++i)
+        text += (i % 7) ? "lovely day " : "beloved\n";
+    text += std::string(5 << 20, 'e') + "love" + std::string(3 << 20, 'x') + " \t" + text;
+    bool same{true};
+    for (const std::string target : {"love", "e", "", "xe", "day beloved"})
+        for (int threads : {1, 2, 3, 8, most_threads}) {
+            const s19c3::Word_count expected{s19c3::count_words(text, target)};
+            const s19c3::Word_count got{s19c3::count_words_parallel(text, target, threads)};
+            same = same && expected.words == got.words && expected.matches == got.matches;
+        }
+    report("counts same as one thread", same ? 1.0 : 0.0, same ? "(yes)" : "(NO)");
+
+    const Mapped_file corpus{corpus_file(parallel_corpus_mb)};
+    const double mib{static_cast<double>(corpus.text().size()) / megabyte};
+    report("cores", omp_get_num_procs(), "");
+
+    keep(s19c3::count_words(corpus.text(), "").words); // fault the pages in, the runs below all find them mapped
+    Stopwatch sw;
+    const s19c3::Word_count expected{s19c3::count_words(corpus.text(), "love")};
+    report("count_words 2 GiB, love", mib / (sw.elapsed_ms() / 1000), "MiB/s");
+
+    double one_thread{0};
+    for (int threads{1}; threads <= most_threads; threads *= 2) {
+        sw.reset();
+        const s19c3::Word_count got{s19c3::count_words_parallel(corpus.text(), "love", threads)};
+        const double rate{mib / (sw.elapsed_ms() / 1000)};
+        if (threads == 1)
+            one_thread = rate;
+        const bool exact{got.words == expected.words && got.matches == expected.matches};
+        report("parallel, " + std::to_string(threads) + " threads", rate, exact ? "MiB/s" : "MiB/s, NOT EXACT");
+        report("  speedup", rate / one_thread, "x");
+    }
+}
+
+void s19c3_keywords_run(void)
+{
+    // every keyword counts what count_words finds for it on its own
+    const std::string play{read_file(data_file("romeoandjuliet_unix.txt"))};
+    std::vector<std::string> odd{make_keywords(300)};
+    odd.insert(odd.end(), {"love", "love", "", "lo ve", "e", "ee", "eee", "\xE2\x80\x99", "Romeo", "R", "omeo"});
+    std::vector<std::size_t> counts;
+    const s19c3::Keyword_counter odd_counter{odd};
+    const std::size_t words{odd_counter.count(play, counts)};
+    bool same{words == s19c3::count_words(play, "").words};
+    for (std::size_t i{0}; i < odd.size(); ++i)
+        same = same && counts[i] == s19c3::count_words(play, odd[i]).matches;
+    report("311 keywords, same as count_words", same ? 1.0 : 0.0, same ? "(yes)" : "(NO)");
+
+    const Mapped_file corpus{corpus_file(keyword_corpus_mb)};
+    const double mib{static_cast<double>(corpus.text().size()) / megabyte};
+    keep(s19c3::count_words(corpus.text(), "").words);
+
+    for (std::size_t n : {std::size_t{10}, std::size_t{1000}, std::size_t{100'000}}) {
+        const std::vector<std::string> keywords{make_keywords(n)};
+        const std::string label{std::to_string(keywords.size()) + " keywords"};
+        Stopwatch sw;
+        const s19c3::Keyword_counter counter{keywords};
+        report(label + ", build", sw.elapsed_ms(), "ms");
+        report(label + ", states", static_cast<double>(counter.states()), "");
+        report(label + ", table", static_cast<double>(counter.table_bytes()) / megabyte, "MiB");
+
+        sw.reset();
+        counter.count(corpus.text(), counts);
+        const double one_pass{sw.elapsed_ms()};
+        report(label + ", one pass", mib / (one_pass / 1000), "MiB/s");
+
+        // a pass of count_words per keyword, timed on the first 10 and scaled up
+        const std::size_t timed{std::min<std::size_t>(keywords.size(), 10)};
+        bool exact{true};
+        sw.reset();
+        for (std::size_t i{0}; i < timed; ++i)
+            exact = exact && s19c3::count_words(corpus.text(), keywords[i]).matches == counts[i];
+        const double per_keyword{sw.elapsed_ms() / static_cast<double>(timed)};
+        report(label + ", a pass each", per_keyword * static_cast<double>(keywords.size()),
+               exact ? "ms" : "ms, NOT THE SAME");
+        report(label + ", one pass", one_pass, "ms");
+    }
+}
+
+void s20c3_count_run(void)
+{
+    // the words file of the challenge, the play, and text with every kind of whitespace and punctuation
+    const std::string odd{(std::filesystem::temp_directory_path() / "udemy1_s20c3_odd.txt").string()};
+    {
+        std::ofstream ofs{odd, std::ios::binary};
+        ofs << "a. .a ... , ;: a.b.c:: \t\v\f\r\n The the THE the; ;the \xC3\xA9t\xC3\xA9 \xFF z" << std::string(40, 'w')
+            << " ,\n\n..";
+    }
+    bool same{true};
+    for (const std::string& file : {data_file("s20c3_words.txt"), data_file("romeoandjuliet_unix.txt"), odd})
+        same = same && printed([&] { s20c3::part1(file); }) == printed([&] { s20c3::part1_mapped(file); });
+    std::filesystem::remove(odd);
+    report("part1_mapped prints like part1", same ? 1.0 : 0.0, same ? "(yes)" : "(NO)");
+
+    const std::string small{corpus_file(count_map_corpus_mb)};
+    double mib{static_cast<double>(std::filesystem::file_size(small)) / megabyte};
+    Stopwatch sw;
+    const std::string by_map{printed([&] { s20c3::part1(small); })};
+    double ms{sw.elapsed_ms()};
+    report("part1, 64 MiB", ms, "ms");
+    report("  rate", mib / (ms / 1000), "MiB/s");
+
+    sw.reset();
+    const std::string by_table{printed([&] { s20c3::part1_mapped(small); })};
+    ms = sw.elapsed_ms();
+    report("part1_mapped, 64 MiB", ms, by_table == by_map ? "ms" : "ms, NOT THE SAME");
+    report("  rate", mib / (ms / 1000), "MiB/s");
+
+    const std::string corpus{corpus_file(count_corpus_mb)};
+    mib = static_cast<double>(std::filesystem::file_size(corpus)) / megabyte;
+    sw.reset();
+    quietly([&] {
+        s20c3::part1_mapped(corpus);
+        return 0;
+    });
+    ms = sw.elapsed_ms();
+    report("part1_mapped, 1 GiB", ms, "ms");
+    report("  rate", mib / (ms / 1000), "MiB/s");
+
+    const Mapped_file file{corpus};
+    s20c3::Word_table table;
+    sw.reset();
+    s20c3::count_words(file.text(), table);
+    ms = sw.elapsed_ms();
+    report("count_words alone", mib / (ms / 1000), "MiB/s");
+    report("distinct words", static_cast<double>(table.size()), "");
+    report("table memory", static_cast<double>(table.memory()) / 1024, "KiB");
+}
+
+void s20c3_parallel_run(void)
+{
+    // both parts print what the std::map parts print, whatever the threads; a few MiB make several pieces
+    const std::string small{corpus_file(count_map_corpus_mb)};
+    const std::string by_map1{printed([&] { s20c3::part1(small); })};
+    const std::string by_map2{printed([&] { s20c3::part2(small); })};
+    bool same{true};
+    for (int threads{1}; threads <= most_threads; threads *= 2)
+        same = same && printed([&] { s20c3::part1_parallel(small, threads); }) == by_map1 &&
+               printed([&] { s20c3::part2_parallel(small, threads); }) == by_map2;
+    report("parts print like the std::map parts", same ? 1.0 : 0.0, same ? "(yes)" : "(NO)");
+    report("cores", omp_get_num_procs(), "");
+
+    const Mapped_file corpus{corpus_file(count_corpus_mb)};
+    double mib{static_cast<double>(corpus.text().size()) / megabyte};
+    s20c3::Word_table one;
+    s20c3::count_words(corpus.text(), one); // fault the pages in, the runs below all find them mapped
+    const std::vector<s20c3::Word_table::Entry> expected{one.sorted()};
+
+    double one_thread{0};
+    for (int threads{1}; threads <= most_threads; threads *= 2) {
+        Stopwatch sw;
+        const std::vector<s20c3::Word_table> parts{s20c3::count_words_parallel(corpus.text(), threads)};
+        const std::vector<s20c3::Word_table::Entry> got{s20c3::sorted(parts)};
+        const double rate{mib / (sw.elapsed_ms() / 1000)};
+        if (threads == 1)
+            one_thread = rate;
+        const bool exact{std::equal(got.begin(), got.end(), expected.begin(), expected.end(),
+            [](const auto& a, const auto& b) { return a.word == b.word && a.count == b.count; })};
+        report("part1 1 GiB, " + std::to_string(threads) + " threads", rate, exact ? "MiB/s" : "MiB/s, NOT EXACT");
+        report("  speedup", rate / one_thread, "x");
+    }
+
+    const Mapped_file text{corpus_file(index_corpus_mb)};
+    mib = static_cast<double>(text.text().size()) / megabyte;
+    s20c3::Line_table lines;
+    s20c3::index_words(text.text(), lines);
+    const std::vector<s20c3::Line_table::Entry> expected_lines{lines.sorted()};
+    report("part2 postings", static_cast<double>(lines.size_postings()), "");
+
+    for (int threads{1}; threads <= most_threads; threads *= 2) {
+        Stopwatch sw;
+        const std::vector<s20c3::Line_table> parts{s20c3::index_words_parallel(text.text(), threads)};
+        const std::vector<s20c3::Line_table::Entry> got{s20c3::sorted(parts)};
+        const double rate{mib / (sw.elapsed_ms() / 1000)};
+        if (threads == 1)
+            one_thread = rate;
+        const bool exact{std::equal(got.begin(), got.end(), expected_lines.begin(), expected_lines.end(),
+            [](const auto& a, const auto& b) {
+                return a.word == b.word && std::equal(a.lines.begin(), a.lines.end(), b.lines.begin(), b.lines.end());
+            })};
+        report("part2 512 MiB, " + std::to_string(threads) + " threads", rate, exact ? "MiB/s" : "MiB/s, NOT EXACT");
+        report("  speedup", rate / one_thread, "x");
+    }
+}
+
+void s20c3_index_run(void)
+{
+    const std::string odd{(std::filesystem::temp_directory_path() / "udemy1_s20c3_odd.txt").string()};
+    {
+        std::ofstream ofs{odd, std::ios::binary};
+        ofs << "a. .a ... , ;: a.b.c::\n\n\r\n \t\v\f\r\n The the THE\nthe; ;the \xC3\xA9t\xC3\xA9 \xFF z\n"
+            << std::string(400, '\n') << "z" << std::string(20000, '\n') << "a z\n ,";
+    }
+    bool same{true};
+    for (const std::string& file : {data_file("s20c3_words.txt"), data_file("romeoandjuliet_unix.txt"), odd})
+        same = same && printed([&] { s20c3::part2(file); }) == printed([&] { s20c3::part2_indexed(file); });
+    std::filesystem::remove(odd);
+    report("part2_indexed prints like part2", same ? 1.0 : 0.0, same ? "(yes)" : "(NO)");
+
+    // the std::map and the index of the same text, built one after the other
+    const std::string small{corpus_file(count_map_corpus_mb)};
+    std::size_t heap_before{heap_in_use()};
+    Stopwatch sw;
+    std::map<std::string, std::set<int>> by_map{map_of_lines(small)};
+    double ms{sw.elapsed_ms()};
+    const std::size_t map_bytes{heap_in_use() - heap_before};
+    std::size_t postings{0};
+    for (const auto& [word, lines] : by_map)
+        postings += lines.size();
+    report("std::map build, 64 MiB", ms, "ms");
+    report("  postings", static_cast<double>(postings), "");
+    report("  bytes per posting", static_cast<double>(map_bytes) / postings, "B");
+
+    const Mapped_file file{small};
+    sw.reset();
+    const s20c3::Line_index index{s20c3::build_index(file.text(), 1)};
+    ms = sw.elapsed_ms();
+    report("Line_index build, 64 MiB", ms, "ms");
+    report("  bytes per posting", static_cast<double>(index.memory()) / index.size_postings(), "B");
+
+    bool found{index.size() == by_map.size() && index.size_postings() == postings};
+    for (const auto& [word, lines] : by_map) {
+        const s20c3::Line_index::Lines got{index.lookup(word)};
+        found = found && std::equal(got.begin(), got.end(), lines.begin(), lines.end(),
+                             [](std::uint32_t a, int b) { return a == static_cast<std::uint32_t>(b); });
+    }
+    found = found && index.lookup("not-a-word-of-the-play").empty();
+    report("lookup finds the lines of the map", found ? 1.0 : 0.0, found ? "(yes)" : "(NO)");
+
+    std::vector<std::string> asked;
+    for (const auto& [word, lines] : by_map)
+        asked.push_back(word + (asked.size() % 2 ? "" : "?")); // half of them not there
+    by_map.clear();
+    constexpr int lookups{1'000'000};
+    std::size_t first_lines{0};
+    sw.reset();
+    for (int i{0}; i < lookups; ++i) {
+        const s20c3::Line_index::Lines got{index.lookup(asked[static_cast<std::size_t>(i) % asked.size()])};
+        first_lines += got.empty() ? 0 : *got.begin();
+    }
+    ms = sw.elapsed_ms();
+    keep(first_lines);
+    report("lookup", ms * 1e6 / lookups, "ns");
+
+    std::size_t walked{0};
+    sw.reset();
+    for (std::size_t i{0}; i < index.size(); ++i)
+        for (const std::uint32_t line : index[i].lines)
+            walked += line;
+    ms = sw.elapsed_ms();
+    keep(walked);
+    report("iterate every posting", static_cast<double>(index.size_postings()) / (ms / 1000) / 1e6, "M/s");
+
+    const Mapped_file big{corpus_file(index_corpus_mb)};
+    sw.reset();
+    const s20c3::Line_index large{s20c3::build_index(big.text(), 1)};
+    ms = sw.elapsed_ms();
+    report("Line_index build, 512 MiB", ms, "ms");
+    report("  postings", static_cast<double>(large.size_postings()), "");
+    report("  bytes per posting", static_cast<double>(large.memory()) / large.size_postings(), "B");
+}
+
+void s20c3_query_run(void)
+{
+    // the lines of a query, worked out from the std::map of part2
+    const std::string play_file{data_file("romeoandjuliet_unix.txt")};
+    const std::map<std::string, std::set<int>> by_map{map_of_lines(play_file)};
+    auto lines_of = [&](const std::vector<std::vector<std::string>>& either) {
+        std::set<std::uint32_t> found;
+        for (const std::vector<std::string>& words : either) {
+            std::map<int, std::size_t> on; // line, words of the side on it
+            for (const std::string& w : words)
+                if (const auto it{by_map.find(w)}; it != by_map.end())
+                    for (const int line : it->second)
+                        ++on[line];
+            for (const auto& [line, n] : on)
+                if (n == words.size())
+                    found.insert(static_cast<std::uint32_t>(line));
+        }
+        return std::vector<std::uint32_t>(found.begin(), found.end());
+    };
+
+    const std::string play_index{(std::filesystem::temp_directory_path() / "udemy1_s20c3_play.idx").string()};
+    const Mapped_file play{play_file};
+    const bool saved{s20c3::build_index(play.text(), 1).save(play_index)};
+    const s20c3::Line_index reopened{play_index};
+    bool same{saved && reopened.is_open() &&
+              printed([&] { s20c3::part2(play_file); }) == printed([&] { s20c3::display_words(reopened); })};
+    const std::vector<std::pair<std::string, std::vector<std::vector<std::string>>>> checks{
+        {"Romeo", {{"Romeo"}}},
+        {"Romeo Juliet", {{"Romeo", "Juliet"}}},
+        {"Tybalt OR Mercutio", {{"Tybalt"}, {"Mercutio"}}},
+        {"the love OR O Romeo OR nothing-like-it", {{"the", "love"}, {"O", "Romeo"}, {"nothing-like-it"}}},
+        {" OR  thou art OR ", {{"thou", "art"}}},
+        {"not-there the", {{"not-there", "the"}}},
+        {"", {}}};
+    for (const auto& [query, either] : checks)
+        same = same && s20c3::find_lines(reopened, query) == lines_of(either);
+    std::filesystem::remove(play_index);
+    report("saved index finds the lines of the map", same ? 1.0 : 0.0, same ? "(yes)" : "(NO)");
+
+    const std::string corpus{corpus_file(count_corpus_mb)};
+    const std::string index_file{corpus + ".idx"};
+    Stopwatch sw;
+    {
+        const Mapped_file text{corpus};
+        const s20c3::Line_index index{s20c3::build_index(text.text(), 1)};
+        report("build, 1 GiB", sw.elapsed_ms(), "ms");
+        sw.reset();
+        if (!index.save(index_file))
+            report("save", 0, "FAILED");
+        report("save", sw.elapsed_ms(), "ms");
+    }
+    report("index file", static_cast<double>(std::filesystem::file_size(index_file)) / megabyte, "MiB");
+
+    // each query opens the index again, the first time with none of it in the page cache
+    for (const std::string query : {"Gregory", "Romeo Juliet", "Tybalt OR Mercutio", "the"}) {
+        evict(index_file);
+        for (const std::string state : {"cold", "warm"}) {
+            sw.reset();
+            const s20c3::Line_index index{index_file};
+            const std::vector<std::uint32_t> lines{s20c3::find_lines(index, query)};
+            const double ms{sw.elapsed_ms()};
+            report("\"" + query + "\" " + state + ", " + std::to_string(lines.size()) + " lines", ms, "ms");
+        }
+    }
+    std::filesystem::remove(index_file);
+}
+
+void s20c3_incremental_run(void)
+{
+    // a text appended to a piece at a time, cut in a word, after a '\n' or anywhere: after every
+    // update the index file is the file a full build of the text so far writes
+    const std::filesystem::path temp{std::filesystem::temp_directory_path()};
+    const std::string text_file{(temp / "udemy1_s20c3_log.txt").string()};
+    const std::string index_file{text_file + ".idx"};
+    const std::string full_file{text_file + ".full.idx"};
+    auto append = [&](std::string_view bytes) {
+        std::ofstream ofs{text_file, std::ios::binary | std::ios::app};
+        ofs.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    };
+    auto as_built = [&] {
+        {
+            const Mapped_file text{text_file};
+            if (!s20c3::build_index(text.text(), 1).save(full_file))
+                return false;
+        }
+        const Mapped_file full{full_file}, updated{index_file};
+        const bool equal{full.text() == updated.text()};
+        std::filesystem::remove(full_file);
+        return equal;
+    };
+
+    const std::string play{read_file(data_file("romeoandjuliet_unix.txt")) +
+                           "a. .a ... , ;: a.b.c::\n\n\r\n \t\v\f\r\n The the THE\nthe; ;the \xFF z\n" +
+                           std::string(300, '\n') + "z a"};
+    std::mt19937 rng{25};
+    bool same{true};
+    std::size_t updates{0};
+    for (int run{0}; run < 24 && same; ++run) {
+        const std::size_t longest{std::size_t{1} << (4 + run % 12)};
+        const std::size_t stop{longest < 512 ? 4096 : play.size()}; // the short pieces on the start only
+        std::filesystem::remove(index_file);
+        std::ofstream{text_file, std::ios::binary | std::ios::trunc};
+        for (std::size_t at{0}; at < stop && same; ++updates) {
+            std::size_t next{std::min(at + rng() % longest, stop)};
+            if (rng() % 4 == 0) // right after a '\n'
+                next = std::min(play.find('\n', next) + 1, stop);
+            append(std::string_view{play}.substr(at, next - at));
+            same = s20c3::update_index(text_file, index_file, 1) && as_built();
+            at = next;
+        }
+    }
+    report("updates the same as a full build", same ? 1.0 : 0.0, same ? "(yes)" : "(NO)");
+    report("  updates", static_cast<double>(updates), "");
+
+    // a text rewritten shorter is indexed again, the parts print what part1 and part2 print
+    std::ofstream{text_file, std::ios::binary | std::ios::trunc} << play.substr(0, play.size() / 2);
+    same = s20c3::update_index(text_file, index_file, 1) && as_built();
+    std::ofstream{text_file, std::ios::binary | std::ios::trunc} << play.substr(0, play.size() / 3);
+    same = same && printed([&] { s20c3::part1(text_file); }) ==
+                       printed([&] { s20c3::part1_incremental(text_file, index_file, 1); });
+    append(std::string_view{play}.substr(play.size() / 3, 1001));
+    same = same && printed([&] { s20c3::part2(text_file); }) ==
+                       printed([&] { s20c3::part2_incremental(text_file, index_file, 1); }) &&
+           printed([&] { s20c3::part1(text_file); }) ==
+               printed([&] { s20c3::part1_incremental(text_file, index_file, 1); });
+    report("rewritten file, incremental parts", same ? 1.0 : 0.0, same ? "(yes)" : "(NO)");
+
+    // a log of about 1 GiB and then more and more appended to it, each piece ending in a word
+    const Mapped_file corpus{corpus_file(count_corpus_mb)};
+    const std::string_view all{corpus.text()};
+    const std::vector<std::size_t> tails{0, 1, 4, 16, 64}; // MiB
+    std::size_t at{all.size()};
+    for (const std::size_t mb : tails)
+        at -= mb * megabyte + (mb ? 7 : 0);
+    std::ofstream{text_file, std::ios::binary | std::ios::trunc};
+    append(all.substr(0, at));
+    Stopwatch sw;
+    const bool built{s20c3::update_index(text_file, index_file, 1)};
+    report("full build, " + std::to_string(at / megabyte) + " MiB", sw.elapsed_ms(), built ? "ms" : "ms, FAILED");
+    report("  index file", static_cast<double>(std::filesystem::file_size(index_file)) / megabyte, "MiB");
+
+    for (const std::size_t mb : tails) {
+        const std::size_t n{mb * megabyte + (mb ? 7 : 0)};
+        append(all.substr(at, n));
+        at += n;
+
+        evict(index_file); // the next run reads it from the disk, the tail just written is in the page cache
+        sw.reset();
+        s20c3::Line_index index;
+        {
+            const Mapped_file text{text_file};
+            index = s20c3::Line_index{index_file, Mapped_file::Access::sequential}.appended(text.text(), 1);
+        }
+        const double read{sw.elapsed_ms()};
+        sw.reset();
+        const bool saved{index.save(index_file)};
+        const double written{sw.elapsed_ms()};
+
+        sw.reset();
+        same = saved && as_built();
+        const double rebuilt{sw.elapsed_ms()};
+        const std::string label{"append " + std::to_string(mb) + " MiB"};
+        report(label, read + written, same ? "ms" : "ms, NOT THE SAME");
+        report("  appended()", read, "ms");
+        report("  save", written, "ms");
+        report("  full build and compare", rebuilt, "ms");
+    }
+    std::filesystem::remove(text_file);
+    std::filesystem::remove(index_file);
+}
+
+} // namespace udemy1::bench
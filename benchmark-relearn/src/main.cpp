@@ -0,0 +1,70 @@
+/*
+ * Copyright © 2022 by Karthik Jain <krthkj.public@gmail.com>
+ * All Rights Reserved.
+ * Using MIT licence, refer the license file supplied with the project.
+ *
+ * File  : main file
+ * Desc  : Runs the benchmarks named on the command line, or all of them
+ *
+ * Author: Karthik Jain
+ * Date  : 2026-10-17
+ */
+
+#include "udemy1-benchmark.hpp"
+
+#include <iostream>
+#include <map>
+#include <string>
+
+int main(int argc, char** argv)
+{
+    const std::map<std::string, void (*)(void)> benchmarks{
+        {"account_pool", udemy1::bench::account_pool_run},
+        {"account_store", udemy1::bench::account_store_run},
+        {"atom", udemy1::bench::atom_run},
+        {"journal", udemy1::bench::journal_run},
+        {"ledger", udemy1::bench::ledger_run},
+        {"money", udemy1::bench::money_run},
+        {"movie_table", udemy1::bench::movie_table_run},
+        {"movies", udemy1::bench::movies_run},
+        {"movies_batch", udemy1::bench::movies_batch_run},
+        {"movies_file", udemy1::bench::movies_file_run},
+        {"mystring", udemy1::bench::mystring_run},
+        {"mystring_growth", udemy1::bench::mystring_growth_run},
+        {"mystring_map", udemy1::bench::mystring_map_run},
+        {"mystring_simd", udemy1::bench::mystring_simd_run},
+        {"print_sink", udemy1::bench::print_sink_run},
+        {"s15c_posting", udemy1::bench::s15c_posting_run},
+        {"s18c_result", udemy1::bench::s18c_result_run},
+        {"s19c3_keywords", udemy1::bench::s19c3_keywords_run},
+        {"s19c3_parallel", udemy1::bench::s19c3_parallel_run},
+        {"s19c3_search", udemy1::bench::s19c3_search_run},
+        {"s20c3_count", udemy1::bench::s20c3_count_run},
+        {"s20c3_incremental", udemy1::bench::s20c3_incremental_run},
+        {"s20c3_index", udemy1::bench::s20c3_index_run},
+        {"s20c3_parallel", udemy1::bench::s20c3_parallel_run},
+        {"s20c3_query", udemy1::bench::s20c3_query_run},
+    };
+
+    if (argc == 1) {
+        for (const auto& [name, run] : benchmarks) {
+            std::cout << "### " << name << std::endl;
+            run();
+        }
+        return 0;
+    }
+
+    for (int i{1}; i < argc; ++i) {
+        auto it = benchmarks.find(argv[i]);
+        if (it == benchmarks.end()) {
+            std::cerr << "Unknown benchmark: " << argv[i] << "\nAvailable:";
+            for (const auto& entry : benchmarks)
+                std::cerr << " " << entry.first;
+            std::cerr << std::endl;
+            return 1;
+        }
+        std::cout << "### " << it->first << std::endl;
+        it->second();
+    }
+    return 0;
+}
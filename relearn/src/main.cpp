@@ -13,12 +13,17 @@
 #include "udemy1.hpp"
 
 #include <iostream>
+#include <string>
 
 /**
  * @brief Main function call to generate the target executable.
+ *        relearn s20c3 ... hands the rest of the command line to the s20c3 word index.
  */
-int main()
+int main(int argc, char* argv[])
 {
+    if (argc > 1 && std::string{argv[1]} == "s20c3")
+        return udemy1::s20c3_index_main(argc - 2, argv + 2);
+
     std::cout << "[relearn] <func> relearn::main" << std::endl;
     relearn_dl::printlib();
     relearn_sl::printlib();
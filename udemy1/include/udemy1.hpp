@@ -48,6 +48,13 @@ void s20c4_run(void);
 void s21c_run(void);
 void s23c_run(void);
 
+/**
+ * @brief The s20c3 word index from the command line, argv without the program and the "s20c3":
+ *        index <text file> <index file> writes the index of the text, query <index file> <words>
+ *        prints the lines with the words. Returns the exit status.
+ */
+int s20c3_index_main(int argc, const char* const argv[]);
+
 /**
  * @brief Running Section exercises
  */
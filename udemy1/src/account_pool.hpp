@@ -0,0 +1,119 @@
+#ifndef ACCOUNT_POOL_HPP
+#define ACCOUNT_POOL_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace udemy1
+{
+
+/**
+ * @class Basic_account_pool
+ * @file account_pool.hpp
+ * @brief Monotonic arena for the accounts of one hierarchy, s16c, s18c and e17 each name theirs
+ *        Account_pool.
+ *        make<T>(...) constructs the account in the current 1 MiB chunk, one after the other, instead
+ *        of a malloc per new, and hands back a plain Base pointer that the std::vector<Account*>
+ *        functions take as they are. The pool owns every account it made: clear() or the destructor
+ *        runs their destructors, newest first, and frees the chunks in one go.
+ *        Never delete an account that came from a pool.
+ */
+template <typename Base>
+class Basic_account_pool
+{
+  public:
+    static constexpr std::size_t chunk_size{std::size_t{1} << 20};
+
+  private:
+    std::vector<std::unique_ptr<std::byte[]>> chunks;
+    std::vector<Base*> objects; // every account made, in order
+    std::byte* next;            // free space in the last chunk
+    std::size_t left;
+
+    void* allocate(std::size_t size, std::size_t align)
+    {
+        std::size_t pad{(align - reinterpret_cast<std::uintptr_t>(next) % align) % align};
+        if (left < pad + size) {
+            chunks.emplace_back(new std::byte[chunk_size]);
+            next = chunks.back().get();
+            left = chunk_size;
+            pad = 0;
+        }
+        void* p{next + pad};
+        next += pad + size;
+        left -= pad + size;
+        return p;
+    }
+
+  public:
+    Basic_account_pool()
+        : next{nullptr}
+        , left{0}
+    {
+    }
+    ~Basic_account_pool()
+    {
+        clear();
+    }
+    Basic_account_pool(const Basic_account_pool&) = delete;
+    Basic_account_pool& operator=(const Basic_account_pool&) = delete;
+
+    // construct an account of type T in the pool, owned by the pool
+    template <typename T, typename... Args>
+    T* make(Args&&... args)
+    {
+        static_assert(std::is_base_of_v<Base, T>, "the pool only holds accounts of its hierarchy");
+        static_assert(alignof(T) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__ && sizeof(T) <= chunk_size);
+
+        objects.push_back(nullptr); // may throw, before anything is constructed
+        T* acc;
+        try {
+            acc = ::new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+        } catch (...) {
+            objects.pop_back();
+            throw;
+        }
+        objects.back() = acc;
+        return acc;
+    }
+
+    // room for n accounts of up to object_size bytes without growing
+    void reserve(std::size_t n, std::size_t object_size = sizeof(Base))
+    {
+        objects.reserve(objects.size() + n);
+        const std::size_t per_chunk{chunk_size / std::max(object_size, std::size_t{1})};
+        chunks.reserve(chunks.size() + n / per_chunk + 1);
+    }
+
+    std::size_t size(void) const
+    {
+        return objects.size();
+    }
+
+    // the accounts made, in order, for the std::vector<Account*> functions
+    const std::vector<Base*>& accounts(void) const
+    {
+        return objects;
+    }
+
+    // destroy every account and free all the memory at once
+    void clear(void)
+    {
+        for (auto it = objects.rbegin(); it != objects.rend(); ++it)
+            (*it)->~Base();
+        objects.clear();
+        chunks.clear();
+        next = nullptr;
+        left = 0;
+    }
+};
+
+} // namespace udemy1
+
+#endif // ACCOUNT_POOL_HPP
@@ -0,0 +1,140 @@
+#ifndef ACCOUNT_STORE_HPP
+#define ACCOUNT_STORE_HPP
+
+#include "print_sink.hpp"
+
+#include <cstddef>
+#include <iostream>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace udemy1
+{
+
+/**
+ * @class Basic_account_store
+ * @file account_store.hpp
+ * @brief Contiguous container for the concrete accounts of one hierarchy,
+ *        s16c, s18c and e17 each name theirs Account_store.
+ *        Holds the accounts by value as std::variant<Accounts...>, in the order they were added,
+ *        instead of a std::vector<Account*> of objects new'd one by one.
+ *        The bulk operations visit each account with its exact type known and call the members
+ *        qualified with that type (acc.Checking::deposit(amt)), so there is no virtual call and
+ *        no pointer to chase. They behave exactly like the virtual calls on the same accounts.
+ */
+template <typename... Accounts>
+class Basic_account_store
+{
+  public:
+    using value_type = std::variant<Accounts...>;
+
+  private:
+    std::vector<value_type> accounts;
+
+  public:
+    // construct an account of type T at the end of the store
+    template <typename T, typename... Args>
+    T& add(Args&&... args)
+    {
+        return std::get<T>(accounts.emplace_back(std::in_place_type<T>, std::forward<Args>(args)...));
+    }
+
+    void reserve(std::size_t n)
+    {
+        accounts.reserve(n);
+    }
+
+    std::size_t size(void) const
+    {
+        return accounts.size();
+    }
+
+    // call fn(acc) with every account as its concrete type, in order
+    template <typename Fn>
+    void for_each(Fn&& fn)
+    {
+        for (value_type& acc : accounts)
+            std::visit(fn, acc);
+    }
+
+    template <typename Fn>
+    void for_each(Fn&& fn) const
+    {
+        for (const value_type& acc : accounts)
+            std::visit(fn, acc);
+    }
+
+    // deposit amt to every account, returns how many accepted it
+    std::size_t deposit(double amt)
+    {
+        std::size_t done{0};
+        for_each([amt, &done](auto& acc) {
+            using T = std::remove_cvref_t<decltype(acc)>;
+            done += acc.T::deposit(amt);
+        });
+        return done;
+    }
+
+    // withdraw amt from every account, returns how many allowed it
+    std::size_t withdraw(double amt)
+    {
+        std::size_t done{0};
+        for_each([amt, &done](auto& acc) {
+            using T = std::remove_cvref_t<decltype(acc)>;
+            done += acc.T::withdraw(amt);
+        });
+        return done;
+    }
+
+    // the same, writing the line the util helpers print for each account
+    void deposit(double amt, std::ostream& os)
+    {
+        for_each([amt, &os](auto& acc) {
+            using T = std::remove_cvref_t<decltype(acc)>;
+            if (acc.T::deposit(amt))
+                os << "Deposited " << amt << " to ";
+            else
+                os << "Failed Deposit of " << amt << " to ";
+            acc.T::print(os);
+            os << std::endl;
+        });
+    }
+
+    void withdraw(double amt, std::ostream& os)
+    {
+        for_each([amt, &os](auto& acc) {
+            using T = std::remove_cvref_t<decltype(acc)>;
+            if (acc.T::withdraw(amt))
+                os << "Withdrew " << amt << " from ";
+            else
+                os << "Failed Withdrawal of " << amt << " from ";
+            acc.T::print(os);
+            os << std::endl;
+        });
+    }
+
+    // print every account on its own line
+    void print(std::ostream& os) const
+    {
+        for_each([&os](const auto& acc) {
+            using T = std::remove_cvref_t<decltype(acc)>;
+            acc.T::print(os);
+            os << std::endl;
+        });
+    }
+
+    void print(Print_sink& out) const
+    {
+        for_each([&out](const auto& acc) {
+            using T = std::remove_cvref_t<decltype(acc)>;
+            acc.T::print(out);
+            out << '\n';
+        });
+    }
+};
+
+} // namespace udemy1
+
+#endif // ACCOUNT_STORE_HPP
@@ -0,0 +1,69 @@
+#include "atom_table.hpp"
+
+#include <mutex>
+
+namespace udemy1::myclass
+{
+
+//------------------------------------------------------------------------------------
+std::string_view Atom::view(void) const
+{
+    return (entry == nullptr) ? std::string_view{} : std::string_view{*entry};
+}
+
+const char* Atom::getStr(void) const
+{
+    return (entry == nullptr) ? "" : entry->getStr();
+}
+
+int Atom::getLength(void) const
+{
+    return (entry == nullptr) ? 0 : entry->getLength();
+}
+
+std::ostream& operator<<(std::ostream& os, const Atom& rhs)
+{
+    os << rhs.getStr();
+    return os;
+}
+
+//------------------------------------------------------------------------------------
+/**
+ * @brief return the atom for s, storing a copy of s the first time it is seen
+ *
+ * Known strings are found under a shared lock so readers do not block each other,
+ * only the first intern of a new string takes the exclusive lock.
+ * @param s
+ */
+Atom Atom_table::intern(std::string_view s)
+{
+    if (s.empty())
+        return Atom{};
+
+    {
+        std::shared_lock<std::shared_mutex> read{lock};
+        auto it = entries.find(s);
+        if (it != entries.end())
+            return Atom{&*it};
+    }
+
+    std::unique_lock<std::shared_mutex> write{lock};
+    auto it = entries.find(s); // another thread may have stored it in between
+    if (it == entries.end())
+        it = entries.emplace(s).first;
+    return Atom{&*it};
+}
+
+std::size_t Atom_table::size(void) const
+{
+    std::shared_lock<std::shared_mutex> read{lock};
+    return entries.size();
+}
+
+Atom_table& Atom_table::global(void)
+{
+    static Atom_table table;
+    return table;
+}
+
+} // namespace udemy1::myclass
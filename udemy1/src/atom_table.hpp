@@ -0,0 +1,99 @@
+#ifndef ATOM_TABLE_HPP
+#define ATOM_TABLE_HPP
+
+#include "mystring.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <iostream>
+#include <shared_mutex>
+#include <string_view>
+#include <unordered_set>
+
+namespace udemy1::myclass
+{
+
+/**
+ * @class Atom
+ * @file atom_table.hpp
+ * @brief Handle to a string interned in an Atom_table
+ *        one pointer wide, compares and hashes by that pointer in O(1)
+ *        two atoms from the same table are equal exactly when their text is equal,
+ *        atoms from different tables are only comparable through view()
+ *        the empty atom (default constructed, or interning "") is shared by all tables
+ */
+class Atom
+{
+    friend class Atom_table;
+    friend std::ostream& operator<<(std::ostream& os, const Atom& rhs);
+
+  private:
+    const Mystring* entry; // the single stored copy, nullptr for the empty atom
+
+    explicit Atom(const Mystring* e)
+        : entry{e}
+    {
+    }
+
+  public:
+    Atom()
+        : entry{nullptr}
+    {
+    }
+
+    bool operator==(const Atom& rhs) const
+    {
+        return entry == rhs.entry;
+    }
+
+    bool operator!=(const Atom& rhs) const
+    {
+        return entry != rhs.entry;
+    }
+
+    std::size_t hash(void) const
+    {
+        return std::hash<const void*>{}(entry);
+    }
+
+    std::string_view view(void) const; // the interned text
+    const char* getStr(void) const;    // the interned text as a C-style string
+    int getLength(void) const;         // length of the interned text
+};
+
+/**
+ * @class Atom_table
+ * @file atom_table.hpp
+ * @brief Stores each distinct string once and hands out Atom handles to it
+ *        intern() is safe to call from many threads, lookups of known strings only take a shared lock
+ *        use global() for one table per process, or own an Atom_table as an arena, the atoms it hands
+ *        out stay valid until the table is destroyed
+ */
+class Atom_table
+{
+  private:
+    mutable std::shared_mutex lock;
+    std::unordered_set<Mystring> entries; // node based, so the stored strings never move
+
+  public:
+    Atom_table() = default;
+    Atom_table(const Atom_table&) = delete;
+    Atom_table& operator=(const Atom_table&) = delete;
+
+    Atom intern(std::string_view s); // the atom for s, stored on first use
+    std::size_t size(void) const;    // number of distinct strings stored
+
+    static Atom_table& global(void); // process wide table
+};
+
+} // namespace udemy1::myclass
+
+template <>
+struct std::hash<udemy1::myclass::Atom> {
+    std::size_t operator()(const udemy1::myclass::Atom& a) const noexcept
+    {
+        return a.hash();
+    }
+};
+
+#endif // ATOM_TABLE_HPP
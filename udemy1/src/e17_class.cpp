@@ -35,6 +35,12 @@ std::ostream& operator<<(std::ostream& os, const I_Printable& obj)
     return os;
 }
 
+Print_sink& operator<<(Print_sink& out, const I_Printable& obj)
+{
+    obj.print(out);
+    return out;
+}
+
 Account::Account(std::string name, double balance)
     : name{name}
     , balance{balance}
@@ -60,11 +66,20 @@ bool Account::withdraw(double amount)
         return false;
 }
 
+template <typename Out>
+void Account::write_to(Out& out) const
+{
+    out << "[Account: " << name << ": " << Fixed{balance, 2} << "]";
+}
+
 void Account::print(std::ostream& os) const
 {
-    os.precision(2);
-    os << std::fixed;
-    os << "[Account: " << name << ": " << balance << "]";
+    write_to(os);
+}
+
+void Account::print(Print_sink& out) const
+{
+    write_to(out);
 }
 
 Checking_Account::Checking_Account(std::string name, double balance)
@@ -83,11 +98,20 @@ bool Checking_Account::withdraw(double amount)
     return Account::withdraw(amount);
 }
 
+template <typename Out>
+void Checking_Account::write_to(Out& out) const
+{
+    out << "[Checking_Account: " << name << ": " << Fixed{balance, 2} << "]";
+}
+
 void Checking_Account::print(std::ostream& os) const
 {
-    os.precision(2);
-    os << std::fixed;
-    os << "[Checking_Account: " << name << ": " << balance << "]";
+    write_to(os);
+}
+
+void Checking_Account::print(Print_sink& out) const
+{
+    write_to(out);
 }
 
 Savings_Account::Savings_Account(std::string name, double balance, double int_rate)
@@ -111,11 +135,20 @@ bool Savings_Account::withdraw(double amount)
     return Account::withdraw(amount);
 }
 
+template <typename Out>
+void Savings_Account::write_to(Out& out) const
+{
+    out << "[Savings_Account: " << name << ": " << Fixed{balance, 2} << ", " << Fixed{int_rate, 2} << "]";
+}
+
 void Savings_Account::print(std::ostream& os) const
 {
-    os.precision(2);
-    os << std::fixed;
-    os << "[Savings_Account: " << name << ": " << balance << ", " << int_rate << "]";
+    write_to(os);
+}
+
+void Savings_Account::print(Print_sink& out) const
+{
+    write_to(out);
 }
 
 Trust_Account::Trust_Account(std::string name, double balance, double int_rate)
@@ -143,20 +176,30 @@ bool Trust_Account::withdraw(double amount)
     }
 }
 
+template <typename Out>
+void Trust_Account::write_to(Out& out) const
+{
+    out << "[Trust Account: " << name << ": " << Fixed{balance, 2} << ", " << Fixed{int_rate, 2}
+        << "%, withdrawals: " << num_withdrawals << "]";
+}
+
 void Trust_Account::print(std::ostream& os) const
 {
-    os.precision(2);
-    os << std::fixed;
-    os << "[Trust Account: " << name << ": " << balance << ", " << int_rate << "%, withdrawals: " << num_withdrawals
-       << "]";
+    write_to(os);
+}
+
+void Trust_Account::print(Print_sink& out) const
+{
+    write_to(out);
 }
 
 // Displays Account objects in a  vector of Account object pointers
 void display(const std::vector<Account*>& accounts)
 {
     std::cout << "\n=== Accounts===========================================" << std::endl;
+    Print_sink out{std::cout};
     for (const auto acc : accounts)
-        std::cout << *acc << std::endl;
+        out << *acc << '\n';
 }
 
 // Deposits supplied amount to each Account object in the vector
@@ -183,4 +226,26 @@ void withdraw(std::vector<Account*>& accounts, double amount)
     }
 }
 
+// Displays Account objects in an Account_store
+void display(const Account_store& accounts)
+{
+    std::cout << "\n=== Accounts===========================================" << std::endl;
+    Print_sink out{std::cout};
+    accounts.print(out);
+}
+
+// Deposits supplied amount to each Account object in the store
+void deposit(Account_store& accounts, double amount)
+{
+    std::cout << "\n=== Depositing to Accounts =================================" << std::endl;
+    accounts.deposit(amount, std::cout);
+}
+
+// Withdraw amount from each Account object in the store
+void withdraw(Account_store& accounts, double amount)
+{
+    std::cout << "\n=== Withdrawing from Accounts ==============================" << std::endl;
+    accounts.withdraw(amount, std::cout);
+}
+
 } // namespace udemy1::e17::ex2
@@ -1,6 +1,10 @@
 #ifndef E17_CLASS_HPP
 #define E17_CLASS_HPP
 
+#include "account_pool.hpp"
+#include "account_store.hpp"
+#include "print_sink.hpp"
+
 #include <iostream>
 #include <memory>
 #include <vector>
@@ -32,9 +36,11 @@ namespace udemy1::e17::ex2
 class I_Printable
 {
     friend std::ostream& operator<<(std::ostream& os, const I_Printable& obj);
+    friend Print_sink& operator<<(Print_sink& out, const I_Printable& obj);
 
   public:
     virtual void print(std::ostream& os) const = 0;
+    virtual void print(Print_sink& out) const = 0; // the same bytes, buffered
     virtual ~I_Printable() = default;
 };
 
@@ -53,7 +59,12 @@ class Account : public I_Printable
     virtual bool deposit(double amount) = 0;
     virtual bool withdraw(double amount) = 0;
     virtual void print(std::ostream& os) const override;
+    virtual void print(Print_sink& out) const override;
     virtual ~Account() = default;
+
+  private:
+    template <typename Out>
+    void write_to(Out& out) const; // the one format of both prints
 };
 
 class Checking_Account : public Account
@@ -68,7 +79,12 @@ class Checking_Account : public Account
     virtual bool withdraw(double) override;
     virtual bool deposit(double) override;
     virtual void print(std::ostream& os) const override;
+    virtual void print(Print_sink& out) const override;
     virtual ~Checking_Account() = default;
+
+  private:
+    template <typename Out>
+    void write_to(Out& out) const; // the one format of both prints
 };
 
 class Savings_Account : public Account
@@ -86,7 +102,12 @@ class Savings_Account : public Account
     virtual bool deposit(double amount) override;
     virtual bool withdraw(double amount) override;
     virtual void print(std::ostream& os) const override;
+    virtual void print(Print_sink& out) const override;
     virtual ~Savings_Account() = default;
+
+  private:
+    template <typename Out>
+    void write_to(Out& out) const; // the one format of both prints
 };
 
 class Trust_Account : public Savings_Account
@@ -112,6 +133,11 @@ class Trust_Account : public Savings_Account
     // Only allowed maximum of 3 withdrawals, each can be up to a maximum of 20% of the account's value
     virtual bool withdraw(double amount) override;
     virtual void print(std::ostream& os) const override;
+    virtual void print(Print_sink& out) const override;
+
+  private:
+    template <typename Out>
+    void write_to(Out& out) const; // the one format of both prints
 };
 
 // Utility helper functions for Account * class
@@ -119,6 +145,17 @@ class Trust_Account : public Savings_Account
 void display(const std::vector<Account*>& accounts);
 void deposit(std::vector<Account*>& accounts, double amount);
 void withdraw(std::vector<Account*>& accounts, double amount);
+
+// Accounts held by value in one vector, the bulk calls need no virtual dispatch
+using Account_store = udemy1::Basic_account_store<Checking_Account, Savings_Account, Trust_Account>;
+
+// Utility helper functions for Account_store, same output as the ones for std::vector<Account*>
+void display(const Account_store& accounts);
+void deposit(Account_store& accounts, double amount);
+void withdraw(Account_store& accounts, double amount);
+
+// Accounts made one after the other in an arena and released together, use them as Account*
+using Account_pool = udemy1::Basic_account_pool<Account>;
 } // namespace udemy1::e17::ex2
 
 /**
@@ -7,8 +7,9 @@ namespace udemy1::e18::ex7
 void display(const std::vector<Account*>& accounts)
 {
     std::cout << "\n=== Accounts===========================================" << std::endl;
+    Print_sink out{std::cout};
     for (const auto acc : accounts)
-        std::cout << *acc << std::endl;
+        out << *acc << '\n';
 }
 
 // Deposits supplied amount to each Account object in the vector
@@ -60,12 +61,21 @@ bool Trust_Account::withdraw(double amount)
     }
 }
 
+template <typename Out>
+void Trust_Account::write_to(Out& out) const
+{
+    out << "[Trust Account: " << name << ": " << Fixed{balance, 2} << ", " << Fixed{int_rate, 2}
+        << "%, withdrawals: " << num_withdrawals << "]";
+}
+
 void Trust_Account::print(std::ostream& os) const
 {
-    os.precision(2);
-    os << std::fixed;
-    os << "[Trust Account: " << name << ": " << balance << ", " << int_rate << "%, withdrawals: " << num_withdrawals
-       << "]";
+    write_to(os);
+}
+
+void Trust_Account::print(Print_sink& out) const
+{
+    write_to(out);
 }
 
 Savings_Account::Savings_Account(std::string name, double balance, double int_rate)
@@ -89,11 +99,20 @@ bool Savings_Account::withdraw(double amount)
     return Account::withdraw(amount);
 }
 
+template <typename Out>
+void Savings_Account::write_to(Out& out) const
+{
+    out << "[Savings_Account: " << name << ": " << Fixed{balance, 2} << ", " << Fixed{int_rate, 2} << "]";
+}
+
 void Savings_Account::print(std::ostream& os) const
 {
-    os.precision(2);
-    os << std::fixed;
-    os << "[Savings_Account: " << name << ": " << balance << ", " << int_rate << "]";
+    write_to(os);
+}
+
+void Savings_Account::print(Print_sink& out) const
+{
+    write_to(out);
 }
 
 Checking_Account::Checking_Account(std::string name, double balance)
@@ -112,11 +131,20 @@ bool Checking_Account::withdraw(double amount)
     return Account::withdraw(amount);
 }
 
+template <typename Out>
+void Checking_Account::write_to(Out& out) const
+{
+    out << "[Checking_Account: " << name << ": " << Fixed{balance, 2} << "]";
+}
+
 void Checking_Account::print(std::ostream& os) const
 {
-    os.precision(2);
-    os << std::fixed;
-    os << "[Checking_Account: " << name << ": " << balance << "]";
+    write_to(os);
+}
+
+void Checking_Account::print(Print_sink& out) const
+{
+    write_to(out);
 }
 
 std::ostream& operator<<(std::ostream& os, const I_Printable& obj)
@@ -125,6 +153,12 @@ std::ostream& operator<<(std::ostream& os, const I_Printable& obj)
     return os;
 }
 
+Print_sink& operator<<(Print_sink& out, const I_Printable& obj)
+{
+    obj.print(out);
+    return out;
+}
+
 bool Account::deposit(double amount)
 {
     if (amount < 0)
@@ -144,11 +178,20 @@ bool Account::withdraw(double amount)
         return false;
 }
 
+template <typename Out>
+void Account::write_to(Out& out) const
+{
+    out << "[Account: " << name << ": " << Fixed{balance, 2} << "]";
+}
+
 void Account::print(std::ostream& os) const
 {
-    os.precision(2);
-    os << std::fixed;
-    os << "[Account: " << name << ": " << balance << "]";
+    write_to(os);
+}
+
+void Account::print(Print_sink& out) const
+{
+    write_to(out);
 }
 
 } // namespace udemy1::e18::ex7
@@ -160,8 +203,9 @@ namespace udemy1::e18::ex8
 void display(const std::vector<Account*>& accounts)
 {
     std::cout << "\n=== Accounts===========================================" << std::endl;
+    Print_sink out{std::cout};
     for (const auto acc : accounts)
-        std::cout << *acc << std::endl;
+        out << *acc << '\n';
 }
 
 // Deposits supplied amount to each Account object in the vector
@@ -213,12 +257,21 @@ bool Trust_Account::withdraw(double amount)
     }
 }
 
+template <typename Out>
+void Trust_Account::write_to(Out& out) const
+{
+    out << "[Trust Account: " << name << ": " << Fixed{balance, 2} << ", " << Fixed{int_rate, 2}
+        << "%, withdrawals: " << num_withdrawals << "]";
+}
+
 void Trust_Account::print(std::ostream& os) const
 {
-    os.precision(2);
-    os << std::fixed;
-    os << "[Trust Account: " << name << ": " << balance << ", " << int_rate << "%, withdrawals: " << num_withdrawals
-       << "]";
+    write_to(os);
+}
+
+void Trust_Account::print(Print_sink& out) const
+{
+    write_to(out);
 }
 
 Savings_Account::Savings_Account(std::string name, double balance, double int_rate)
@@ -242,11 +295,20 @@ bool Savings_Account::withdraw(double amount)
     return Account::withdraw(amount);
 }
 
+template <typename Out>
+void Savings_Account::write_to(Out& out) const
+{
+    out << "[Savings_Account: " << name << ": " << Fixed{balance, 2} << ", " << Fixed{int_rate, 2} << "]";
+}
+
 void Savings_Account::print(std::ostream& os) const
 {
-    os.precision(2);
-    os << std::fixed;
-    os << "[Savings_Account: " << name << ": " << balance << ", " << int_rate << "]";
+    write_to(os);
+}
+
+void Savings_Account::print(Print_sink& out) const
+{
+    write_to(out);
 }
 
 Checking_Account::Checking_Account(std::string name, double balance)
@@ -265,11 +327,20 @@ bool Checking_Account::withdraw(double amount)
     return Account::withdraw(amount);
 }
 
+template <typename Out>
+void Checking_Account::write_to(Out& out) const
+{
+    out << "[Checking_Account: " << name << ": " << Fixed{balance, 2} << "]";
+}
+
 void Checking_Account::print(std::ostream& os) const
 {
-    os.precision(2);
-    os << std::fixed;
-    os << "[Checking_Account: " << name << ": " << balance << "]";
+    write_to(os);
+}
+
+void Checking_Account::print(Print_sink& out) const
+{
+    write_to(out);
 }
 
 std::ostream& operator<<(std::ostream& os, const I_Printable& obj)
@@ -278,6 +349,12 @@ std::ostream& operator<<(std::ostream& os, const I_Printable& obj)
     return os;
 }
 
+Print_sink& operator<<(Print_sink& out, const I_Printable& obj)
+{
+    obj.print(out);
+    return out;
+}
+
 bool Account::deposit(double amount)
 {
     if (amount < 0)
@@ -297,11 +374,20 @@ bool Account::withdraw(double amount)
         return false;
 }
 
+template <typename Out>
+void Account::write_to(Out& out) const
+{
+    out << "[Account: " << name << ": " << Fixed{balance, 2} << "]";
+}
+
 void Account::print(std::ostream& os) const
 {
-    os.precision(2);
-    os << std::fixed;
-    os << "[Account: " << name << ": " << balance << "]";
+    write_to(os);
+}
+
+void Account::print(Print_sink& out) const
+{
+    write_to(out);
 }
 
 } // namespace udemy1::e18::ex8
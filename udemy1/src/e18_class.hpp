@@ -1,6 +1,8 @@
 #ifndef E18_CLASS_HPP
 #define E18_CLASS_HPP
 
+#include "print_sink.hpp"
+
 #include <iostream>
 #include <string>
 #include <vector>
@@ -10,9 +12,11 @@ namespace udemy1::e18::ex7
 class I_Printable
 {
     friend std::ostream& operator<<(std::ostream& os, const I_Printable& obj);
+    friend Print_sink& operator<<(Print_sink& out, const I_Printable& obj);
 
   public:
     virtual void print(std::ostream& os) const = 0;
+    virtual void print(Print_sink& out) const = 0; // the same bytes, buffered
     virtual ~I_Printable() = default;
 };
 
@@ -31,7 +35,12 @@ class Account : public I_Printable
     virtual bool deposit(double amount) = 0;
     virtual bool withdraw(double amount) = 0;
     virtual void print(std::ostream& os) const override;
+    virtual void print(Print_sink& out) const override;
     virtual ~Account() = default;
+
+  private:
+    template <typename Out>
+    void write_to(Out& out) const; // the one format of both prints
 };
 
 class Checking_Account : public Account
@@ -46,8 +55,13 @@ class Checking_Account : public Account
     virtual bool withdraw(double) override;
     virtual bool deposit(double) override;
     virtual void print(std::ostream& os) const override;
+    virtual void print(Print_sink& out) const override;
 
     virtual ~Checking_Account() = default;
+
+  private:
+    template <typename Out>
+    void write_to(Out& out) const; // the one format of both prints
 };
 
 class Savings_Account : public Account
@@ -65,8 +79,13 @@ class Savings_Account : public Account
     virtual bool deposit(double amount) override;
     virtual bool withdraw(double amount) override;
     virtual void print(std::ostream& os) const override;
+    virtual void print(Print_sink& out) const override;
 
     virtual ~Savings_Account() = default;
+
+  private:
+    template <typename Out>
+    void write_to(Out& out) const; // the one format of both prints
 };
 
 class Trust_Account : public Savings_Account
@@ -92,7 +111,12 @@ class Trust_Account : public Savings_Account
     // Only allowed maximum of 3 withdrawals, each can be up to a maximum of 20% of the account's value
     virtual bool withdraw(double amount) override;
     virtual void print(std::ostream& os) const override;
+    virtual void print(Print_sink& out) const override;
     virtual ~Trust_Account() = default;
+
+  private:
+    template <typename Out>
+    void write_to(Out& out) const; // the one format of both prints
 };
 
 // Utility helper functions for Account class
@@ -107,9 +131,11 @@ namespace udemy1::e18::ex8
 class I_Printable
 {
     friend std::ostream& operator<<(std::ostream& os, const I_Printable& obj);
+    friend Print_sink& operator<<(Print_sink& out, const I_Printable& obj);
 
   public:
     virtual void print(std::ostream& os) const = 0;
+    virtual void print(Print_sink& out) const = 0; // the same bytes, buffered
     virtual ~I_Printable() = default;
 };
 
@@ -128,7 +154,12 @@ class Account : public I_Printable
     virtual bool deposit(double amount) = 0;
     virtual bool withdraw(double amount) = 0;
     virtual void print(std::ostream& os) const override;
+    virtual void print(Print_sink& out) const override;
     virtual ~Account() = default;
+
+  private:
+    template <typename Out>
+    void write_to(Out& out) const; // the one format of both prints
 };
 
 class Checking_Account : public Account
@@ -143,8 +174,13 @@ class Checking_Account : public Account
     virtual bool withdraw(double) override;
     virtual bool deposit(double) override;
     virtual void print(std::ostream& os) const override;
+    virtual void print(Print_sink& out) const override;
 
     virtual ~Checking_Account() = default;
+
+  private:
+    template <typename Out>
+    void write_to(Out& out) const; // the one format of both prints
 };
 
 class Savings_Account : public Account
@@ -162,8 +198,13 @@ class Savings_Account : public Account
     virtual bool deposit(double amount) override;
     virtual bool withdraw(double amount) override;
     virtual void print(std::ostream& os) const override;
+    virtual void print(Print_sink& out) const override;
 
     virtual ~Savings_Account() = default;
+
+  private:
+    template <typename Out>
+    void write_to(Out& out) const; // the one format of both prints
 };
 
 class Trust_Account : public Savings_Account
@@ -189,7 +230,12 @@ class Trust_Account : public Savings_Account
     // Only allowed maximum of 3 withdrawals, each can be up to a maximum of 20% of the account's value
     virtual bool withdraw(double amount) override;
     virtual void print(std::ostream& os) const override;
+    virtual void print(Print_sink& out) const override;
     virtual ~Trust_Account() = default;
+
+  private:
+    template <typename Out>
+    void write_to(Out& out) const; // the one format of both prints
 };
 
 // Utility helper functions for Account class
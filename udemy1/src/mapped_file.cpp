@@ -0,0 +1,73 @@
+#include "mapped_file.hpp"
+
+#include <cstdint>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace udemy1
+{
+
+/**
+ * @brief map the file, the pages are read ahead as the text is gone through from the front, or
+ *        only the page touched for random access
+ */
+Mapped_file::Mapped_file(const std::string& file_name, Access access)
+    : map{nullptr}
+    , map_size{0}
+    , opened{false}
+{
+    const int fd{::open(file_name.c_str(), O_RDONLY)};
+    if (fd < 0)
+        return;
+
+    struct stat st;
+    if (::fstat(fd, &st) == 0) {
+        map_size = static_cast<std::size_t>(st.st_size);
+        if (map_size == 0) {
+            opened = true;
+        } else {
+            map = ::mmap(nullptr, map_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (map == MAP_FAILED) {
+                map = nullptr;
+                map_size = 0;
+            } else {
+                ::madvise(map, map_size, access == Access::sequential ? MADV_SEQUENTIAL : MADV_RANDOM);
+                opened = true;
+            }
+        }
+    }
+    ::close(fd); // the mapping keeps the file
+}
+
+Mapped_file::~Mapped_file()
+{
+    if (map)
+        ::munmap(map, map_size);
+}
+
+bool Mapped_file::is_open(void) const
+{
+    return opened;
+}
+
+std::string_view Mapped_file::text(void) const
+{
+    return {static_cast<const char*>(map), map_size};
+}
+
+/**
+ * @brief the pages part is on, a random access mapping would fault them in one at a time
+ */
+void Mapped_file::will_need(std::string_view part) const
+{
+    if (!map || part.empty())
+        return;
+    const std::uintptr_t page{static_cast<std::uintptr_t>(::sysconf(_SC_PAGESIZE))};
+    const std::uintptr_t first{reinterpret_cast<std::uintptr_t>(part.data()) & ~(page - 1)};
+    const std::uintptr_t last{reinterpret_cast<std::uintptr_t>(part.data()) + part.size()};
+    ::madvise(reinterpret_cast<void*>(first), last - first, MADV_WILLNEED);
+}
+
+} // namespace udemy1
@@ -0,0 +1,41 @@
+#ifndef MAPPED_FILE_HPP
+#define MAPPED_FILE_HPP
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace udemy1
+{
+
+/**
+ * @class Mapped_file
+ * @file mapped_file.hpp
+ * @brief A whole file mapped read only, its bytes read in place instead of through a stream
+ *        An empty file is open with an empty text.
+ */
+class Mapped_file
+{
+  public:
+    // how the text will be gone through, the kernel reads ahead for sequential
+    enum class Access { sequential, random };
+
+  private:
+    void* map;
+    std::size_t map_size;
+    bool opened;
+
+  public:
+    explicit Mapped_file(const std::string& file_name, Access access = Access::sequential);
+    ~Mapped_file(); // unmap
+    Mapped_file(const Mapped_file&) = delete;
+    Mapped_file& operator=(const Mapped_file&) = delete;
+
+    bool is_open(void) const; // false when the file could not be opened or mapped
+    std::string_view text(void) const;
+    void will_need(std::string_view part) const; // read part of the text ahead, in the background
+};
+
+} // namespace udemy1
+
+#endif // MAPPED_FILE_HPP
@@ -0,0 +1,141 @@
+#include "money.hpp"
+
+#include <algorithm>
+#include <omp.h>
+#include <type_traits>
+
+namespace udemy1
+{
+
+static_assert(sizeof(Money) == sizeof(std::int64_t) && std::is_standard_layout_v<Money>);
+static_assert(sizeof(Rate) == sizeof(std::int64_t) && std::is_standard_layout_v<Rate>);
+
+namespace
+{
+constexpr std::int64_t divisor{100 * Rate::scale}; // balance * rate units / divisor = interest
+constexpr std::size_t block{2048};                  // accounts per task
+
+__extension__ typedef __int128 int128;
+
+/**
+ * @brief exact for any balance, the product is worked out in 128 bits
+ */
+std::int64_t interest_units(std::int64_t balance, std::int64_t rate)
+{
+    const int128 p{static_cast<int128>(balance) * rate};
+    return static_cast<std::int64_t>((p + (p < 0 ? -divisor / 2 : divisor / 2)) / divisor);
+}
+
+/**
+ * @brief interest of each account into out, the same as interest_units as long as
+ * |b * r| < 2^53, returns false when some account is past that and was left at 0
+ *
+ * Below 2^53 the product is exact in a double. 64 bit integer multiplies and
+ * divisions are slow or do not vectorise at all, so everything is done in doubles:
+ * the quotient is estimated with a multiply, off by less than 1e-4, truncated, and
+ * corrected from the remainder, which is exact as well.
+ */
+[[gnu::always_inline]] inline bool interest_small(const std::int64_t* b, const std::int64_t* r, std::int64_t* out,
+                                                  std::size_t n)
+{
+    constexpr double d{divisor};
+    double largest{0.0};
+#pragma omp simd reduction(max : largest)
+    for (std::size_t i = 0; i < n; ++i) {
+        const double p{static_cast<double>(b[i]) * static_cast<double>(r[i])};
+        double q{static_cast<double>(static_cast<std::int64_t>(p * (1.0 / d)))};
+        const double rem{p - q * d};
+        q += static_cast<double>(rem >= d / 2) - static_cast<double>(rem <= -d / 2);
+        const bool exact{std::fabs(p) < 0x1p53};
+        out[i] = exact ? static_cast<std::int64_t>(q) : 0;
+        largest = std::max(largest, std::fabs(p));
+    }
+    return largest < 0x1p53;
+}
+
+[[gnu::always_inline]] inline void accrue_in_block(std::int64_t* b, const std::int64_t* r, std::size_t n)
+{
+    std::int64_t interest[block];
+    if (!interest_small(b, r, interest, n))
+        for (std::size_t i{0}; i < n; ++i)
+            if (!(std::fabs(static_cast<double>(b[i]) * static_cast<double>(r[i])) < 0x1p53))
+                interest[i] = interest_units(b[i], r[i]);
+#pragma omp simd
+    for (std::size_t i = 0; i < n; ++i)
+        b[i] += interest[i];
+}
+
+void accrue_block(std::int64_t* b, const std::int64_t* r, std::size_t n)
+{
+    accrue_in_block(b, r, n);
+}
+
+using accrue_fn = void (*)(std::int64_t*, const std::int64_t*, std::size_t);
+
+#if defined(__x86_64__)
+// int64 <-> double conversions only vectorise with AVX-512DQ
+[[gnu::target("avx512f,avx512dq")]] void accrue_block_avx512(std::int64_t* b, const std::int64_t* r, std::size_t n)
+{
+    accrue_in_block(b, r, n);
+}
+#endif
+
+Accrue_kernel detect_kernel(void)
+{
+#if defined(__x86_64__)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512dq"))
+        return Accrue_kernel::avx512;
+#endif
+    return Accrue_kernel::portable;
+}
+
+accrue_fn accrue_with(Accrue_kernel kernel)
+{
+#if defined(__x86_64__)
+    if (kernel == Accrue_kernel::avx512)
+        return accrue_block_avx512;
+#endif
+    return accrue_block;
+}
+} // namespace
+
+Accrue_kernel best_accrue_kernel(void)
+{
+    static const Accrue_kernel kernel{detect_kernel()};
+    return kernel;
+}
+
+Money interest(Money balance, Rate rate)
+{
+    return Money::from_units(interest_units(balance.units(), rate.units()));
+}
+
+/**
+ * @brief add the interest of every account to its balance
+ *
+ * The accounts are split in fixed blocks, each worked out on its own, so how
+ * many threads run them changes nothing in the result. Accounts whose
+ * balance * rate is 2^53 or more, ex.) $30M at 3%, take the 128 bit scalar path.
+ */
+void accrue_interest(std::span<Money> balances, std::span<const Rate> rates, int threads)
+{
+    accrue_interest(balances, rates, threads, best_accrue_kernel());
+}
+
+void accrue_interest(std::span<Money> balances, std::span<const Rate> rates, int threads, Accrue_kernel kernel)
+{
+    if (threads <= 0)
+        threads = omp_get_max_threads();
+
+    const std::size_t n{std::min(balances.size(), rates.size())};
+    std::int64_t* const b{reinterpret_cast<std::int64_t*>(balances.data())};
+    const std::int64_t* const r{reinterpret_cast<const std::int64_t*>(rates.data())};
+    const accrue_fn accrue{accrue_with(std::min(kernel, best_accrue_kernel()))};
+
+#pragma omp parallel for num_threads(threads) schedule(static)
+    for (std::size_t start = 0; start < n; start += block)
+        accrue(b + start, r + start, std::min(block, n - start));
+}
+
+} // namespace udemy1
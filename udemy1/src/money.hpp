@@ -0,0 +1,172 @@
+#ifndef MONEY_HPP
+#define MONEY_HPP
+
+#include <cmath>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <span>
+
+namespace udemy1
+{
+
+/**
+ * @class Basic_money
+ * @file money.hpp
+ * @brief An amount of money as a whole number of minor units, ex.) cents for Decimals = 2
+ *        Adding and subtracting amounts is exact, the only rounding happens when a double
+ *        is turned into money (from_double) and when interest is worked out, both round
+ *        to the nearest minor unit with halves away from zero.
+ *        Prints like the double it stands for, so 1030.5 prints as 1030.5.
+ */
+template <int Decimals>
+class Basic_money
+{
+    static_assert(Decimals >= 0 && Decimals <= 9, "at most nine decimals fit with room to spare");
+
+  public:
+    static constexpr std::int64_t scale{[] {
+        std::int64_t s{1};
+        for (int i{0}; i < Decimals; ++i)
+            s *= 10;
+        return s;
+    }()}; // minor units per whole unit
+
+  private:
+    std::int64_t minor; // amount in minor units
+
+  public:
+    constexpr Basic_money()
+        : minor{0}
+    {
+    }
+
+    static constexpr Basic_money from_units(std::int64_t units)
+    {
+        Basic_money m;
+        m.minor = units;
+        return m;
+    }
+
+    // amount rounded to the nearest minor unit
+    static Basic_money from_double(double amount)
+    {
+        return from_units(std::llround(amount * scale));
+    }
+
+    constexpr std::int64_t units(void) const
+    {
+        return minor;
+    }
+
+    double to_double(void) const
+    {
+        return static_cast<double>(minor) / scale;
+    }
+
+    constexpr Basic_money& operator+=(Basic_money rhs)
+    {
+        minor += rhs.minor;
+        return *this;
+    }
+
+    constexpr Basic_money& operator-=(Basic_money rhs)
+    {
+        minor -= rhs.minor;
+        return *this;
+    }
+
+    friend constexpr Basic_money operator+(Basic_money lhs, Basic_money rhs)
+    {
+        return lhs += rhs;
+    }
+
+    friend constexpr Basic_money operator-(Basic_money lhs, Basic_money rhs)
+    {
+        return lhs -= rhs;
+    }
+
+    friend constexpr Basic_money operator-(Basic_money m)
+    {
+        return from_units(-m.minor);
+    }
+
+    friend constexpr Basic_money operator*(Basic_money m, std::int64_t n)
+    {
+        return from_units(m.minor * n);
+    }
+
+    friend constexpr bool operator==(Basic_money, Basic_money) = default;
+    friend constexpr auto operator<=>(Basic_money, Basic_money) = default;
+
+    friend std::ostream& operator<<(std::ostream& os, Basic_money m)
+    {
+        return os << m.to_double();
+    }
+};
+
+using Money = Basic_money<2>; // dollars and cents
+
+/**
+ * @class Rate
+ * @file money.hpp
+ * @brief An interest rate per period in fixed point, 1e-6 percent per unit (3% is 3'000'000)
+ */
+class Rate
+{
+  public:
+    static constexpr std::int64_t scale{1'000'000}; // units per percent
+
+  private:
+    std::int64_t micro_percent;
+
+  public:
+    constexpr Rate()
+        : micro_percent{0}
+    {
+    }
+
+    static constexpr Rate from_units(std::int64_t units)
+    {
+        Rate r;
+        r.micro_percent = units;
+        return r;
+    }
+
+    // percent rounded to the nearest unit, ex.) 3.0 for 3%
+    static Rate from_percent(double percent)
+    {
+        return from_units(std::llround(percent * scale));
+    }
+
+    constexpr std::int64_t units(void) const
+    {
+        return micro_percent;
+    }
+
+    double percent(void) const
+    {
+        return static_cast<double>(micro_percent) / scale;
+    }
+
+    friend constexpr bool operator==(Rate, Rate) = default;
+};
+
+// balance * rate, rounded to the nearest minor unit with halves away from zero
+Money interest(Money balance, Rate rate);
+
+// the kernels of accrue_interest, all give the same result bit for bit
+enum class Accrue_kernel { portable, avx512 };
+
+Accrue_kernel best_accrue_kernel(void); // the fastest this CPU supports, detected on first use
+
+// balances[i] += interest(balances[i], rates[i]) for each i both spans have,
+// same result, bit for bit, whatever the number of threads (0 uses the OpenMP default)
+void accrue_interest(std::span<Money> balances, std::span<const Rate> rates, int threads = 0);
+// on the given kernel, for benchmarking and testing, one the CPU does not have falls back to the best one
+void accrue_interest(std::span<Money> balances, std::span<const Rate> rates, int threads, Accrue_kernel kernel);
+
+} // namespace udemy1
+
+#endif // MONEY_HPP
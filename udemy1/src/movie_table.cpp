@@ -0,0 +1,269 @@
+/******************************************************************
+ * Section 13 Challenge
+ * movie_table.cpp
+ *
+ * Models a collection of movies column by column
+ *
+ ******************************************************************/
+#include "movie_table.hpp"
+
+#include <algorithm>
+#include <climits>
+#include <functional>
+#include <iostream>
+
+namespace udemy1::s13c
+{
+
+namespace
+{
+constexpr std::size_t top_block{256}; // rows per block skipped as a whole by top_watched
+
+std::uint64_t name_hash(std::string_view name)
+{
+    return std::hash<std::string_view>{}(name);
+}
+} // namespace
+
+// constructor
+Movie_table::Movie_table()
+    : name_offset{0}
+{
+}
+
+std::string_view Movie_table::name(std::size_t row) const
+{
+    return std::string_view{names}.substr(name_offset[row], name_offset[row + 1] - name_offset[row]);
+}
+
+/**
+ * @brief the slot holding name, or the empty slot where it would go
+ */
+std::size_t Movie_table::find_slot(std::string_view name, std::uint64_t h) const
+{
+    const std::size_t mask{index.size() - 1};
+    const std::uint32_t tag{static_cast<std::uint32_t>(h >> 32)};
+    std::size_t slot{h & mask};
+    while (index[slot].row != 0 && (index[slot].tag != tag || this->name(index[slot].row - 1) != name))
+        slot = (slot + 1) & mask;
+    return slot;
+}
+
+/**
+ * @brief double the index, kept at most two thirds full
+ */
+void Movie_table::grow_index(void)
+{
+    std::vector<Slot> old(std::max<std::size_t>(16, 2 * index.size()), Slot{0, 0});
+    old.swap(index);
+
+    const std::size_t mask{index.size() - 1};
+    for (const Slot& s : old) {
+        if (s.row == 0)
+            continue;
+        std::size_t slot{name_hash(name(s.row - 1)) & mask};
+        while (index[slot].row != 0)
+            slot = (slot + 1) & mask;
+        index[slot] = s;
+    }
+}
+
+int Movie_table::rating_code(std::string_view name) const
+{
+    for (std::size_t code{0}; code < ratings.size(); ++code)
+        if (ratings[code] == name)
+            return static_cast<int>(code);
+    return -1;
+}
+
+/**
+ * @brief add_movie expects the name of the move, rating and watched count
+ *
+ * Returns false when a movie with the same name is already in the table,
+ * or when the rating would be the 257th different one.
+ * Otherwise the movie is appended to every column and true is returned.
+ */
+bool Movie_table::add_movie(std::string_view name, std::string_view rating, int watched)
+{
+    if (3 * (size() + 1) > 2 * index.size())
+        grow_index();
+
+    const std::uint64_t h{name_hash(name)};
+    const std::size_t slot{find_slot(name, h)};
+    if (index[slot].row != 0 || size() >= UINT32_MAX - 1)
+        return false;
+
+    int code{rating_code(rating)};
+    if (code < 0) {
+        if (ratings.size() > UINT8_MAX)
+            return false;
+        code = static_cast<int>(ratings.size());
+        ratings.emplace_back(rating);
+    }
+
+    index[slot] = Slot{static_cast<std::uint32_t>(size() + 1), static_cast<std::uint32_t>(h >> 32)};
+    this->watched.push_back(watched);
+    this->rating.push_back(static_cast<std::uint8_t>(code));
+    names.append(name);
+    name_offset.push_back(names.size());
+    return true;
+}
+
+/**
+ * @brief increment_watched expects the name of the move to increment the
+ * watched count
+ *
+ * Returns false when no movie with that name is in the table
+ */
+bool Movie_table::increment_watched(std::string_view name)
+{
+    if (index.empty())
+        return false;
+    const Slot& slot{index[find_slot(name, name_hash(name))]};
+    if (slot.row == 0)
+        return false;
+    ++watched[slot.row - 1];
+    return true;
+}
+
+/**
+ * @brief display all the movies in the order they were added,
+ * byte for byte what Movies::display prints for the same movies
+ */
+void Movie_table::display(void) const
+{
+    if (size() == 0) {
+        std::cout << "Sorry, no movies to display" << std::endl << std::endl;
+        return;
+    }
+
+    std::cout << std::endl << "===================================" << std::endl;
+    for (std::size_t i{0}; i < size(); ++i)
+        std::cout << name(i) << ", " << ratings[rating[i]] << ", " << watched[i] << '\n';
+    std::cout << "===================================" << std::endl << std::endl;
+}
+
+std::size_t Movie_table::size(void) const
+{
+    return watched.size();
+}
+
+Movie_row Movie_table::row(std::size_t row) const
+{
+    return Movie_row{name(row), ratings[rating[row]], watched[row]};
+}
+
+long long Movie_table::total_watched(void) const
+{
+    const std::int32_t* const w{watched.data()};
+    long long sum{0};
+#pragma omp simd reduction(+ : sum)
+    for (std::size_t i = 0; i < watched.size(); ++i)
+        sum += w[i];
+    return sum;
+}
+
+/**
+ * @brief sum of the watched column over the rows with this rating,
+ * the rating compare becomes an all ones / all zeros mask, so the loop
+ * has no branch and vectorises
+ */
+long long Movie_table::total_watched(std::string_view rating) const
+{
+    const int code{rating_code(rating)};
+    if (code < 0)
+        return 0;
+
+    const std::int32_t* const w{watched.data()};
+    const std::uint8_t* const r{this->rating.data()};
+    const std::uint8_t c{static_cast<std::uint8_t>(code)};
+    long long sum{0};
+#pragma omp simd reduction(+ : sum)
+    for (std::size_t i = 0; i < watched.size(); ++i)
+        sum += w[i] & -static_cast<std::int32_t>(r[i] == c);
+    return sum;
+}
+
+/**
+ * @brief total watches per rating, in the order the ratings were first seen
+ *
+ * A handful of ratings are summed with one masked pass each, which vectorises,
+ * beyond that a single scalar pass with one counter per rating is cheaper.
+ */
+std::vector<std::pair<std::string, long long>> Movie_table::watched_by_rating(void) const
+{
+    std::vector<std::pair<std::string, long long>> totals;
+    if (ratings.size() <= 8) {
+        for (const std::string& r : ratings)
+            totals.emplace_back(r, total_watched(r));
+        return totals;
+    }
+
+    std::vector<long long> sums(ratings.size(), 0);
+    for (std::size_t i{0}; i < size(); ++i)
+        sums[rating[i]] += watched[i];
+    for (std::size_t code{0}; code < ratings.size(); ++code)
+        totals.emplace_back(ratings[code], sums[code]);
+    return totals;
+}
+
+/**
+ * @brief the k most watched movies with this rating, most watched first,
+ * equal counts in the order the movies were added
+ *
+ * The k best so far are kept in a heap. Once it is full, each block of rows
+ * first gets its largest watched count for the rating in a vectorised pass,
+ * blocks that can not beat the heap are skipped without looking at their rows.
+ */
+std::vector<Movie_row> Movie_table::top_watched(std::size_t k, std::string_view rating) const
+{
+    const int code{rating_code(rating)};
+    if (code < 0 || k == 0)
+        return {};
+
+    using entry = std::pair<std::int32_t, std::size_t>; // watched, row
+    const auto better = [](const entry& a, const entry& b) {
+        return a.first > b.first || (a.first == b.first && a.second < b.second);
+    };
+    std::vector<entry> best; // heap, front() is the worst entry kept
+
+    const std::int32_t* const w{watched.data()};
+    const std::uint8_t* const r{this->rating.data()};
+    const std::uint8_t c{static_cast<std::uint8_t>(code)};
+    for (std::size_t start{0}; start < size(); start += top_block) {
+        const std::size_t end{std::min(start + top_block, size())};
+        if (best.size() == k) {
+            std::int32_t block_max{INT32_MIN};
+#pragma omp simd reduction(max : block_max)
+            for (std::size_t i = start; i < end; ++i) {
+                const std::int32_t mask{-static_cast<std::int32_t>(r[i] == c)};
+                block_max = std::max(block_max, (w[i] & mask) | (INT32_MIN & ~mask));
+            }
+            if (block_max <= best.front().first) // later rows lose the ties
+                continue;
+        }
+
+        for (std::size_t i{start}; i < end; ++i) {
+            if (r[i] != c)
+                continue;
+            const entry candidate{w[i], i};
+            if (best.size() < k) {
+                best.push_back(candidate);
+                std::push_heap(best.begin(), best.end(), better);
+            } else if (better(candidate, best.front())) {
+                std::pop_heap(best.begin(), best.end(), better);
+                best.back() = candidate;
+                std::push_heap(best.begin(), best.end(), better);
+            }
+        }
+    }
+
+    std::sort_heap(best.begin(), best.end(), better);
+    std::vector<Movie_row> rows;
+    rows.reserve(best.size());
+    for (const entry& e : best)
+        rows.push_back(row(e.second));
+    return rows;
+}
+
+} // namespace udemy1::s13c
@@ -0,0 +1,73 @@
+/******************************************************************
+ * Section 13 Challenge
+ * movie_table.hpp
+ *
+ * Models a collection of movies column by column
+ *
+ * Same add_movie / increment_watched / display behaviour as Movies,
+ * but every attribute has its own array:
+ *   watched   int per movie
+ *   rating    one byte per movie, a code into the rating dictionary
+ *   name      all names back to back in one string, with their offsets
+ * so a scan over one attribute only reads that attribute.
+ ******************************************************************/
+
+#ifndef MOVIE_TABLE_HPP
+#define MOVIE_TABLE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace udemy1::s13c
+{
+// one movie of a Movie_table, the views stay valid until the table is changed
+struct Movie_row {
+    std::string_view name;
+    std::string_view rating;
+    int watched;
+};
+
+class Movie_table
+{
+  private:
+    struct Slot {
+        std::uint32_t row; // row + 1, 0 for an empty slot
+        std::uint32_t tag; // upper half of the name hash, skips most string compares
+    };
+
+    std::vector<std::int32_t> watched;      // watched column
+    std::vector<std::uint8_t> rating;       // rating column, codes into ratings
+    std::vector<std::string> ratings;       // rating dictionary, at most 256 entries
+    std::string names;                      // name column, every name back to back
+    std::vector<std::uint64_t> name_offset; // name i is [name_offset[i], name_offset[i + 1]) of names
+    std::vector<Slot> index;                // name -> row, open addressing with linear probing
+
+    std::string_view name(std::size_t row) const;
+    std::size_t find_slot(std::string_view name, std::uint64_t h) const;
+    void grow_index(void);
+    int rating_code(std::string_view name) const; // -1 when the rating is not in the dictionary
+
+  public:
+    Movie_table();
+
+    bool add_movie(std::string_view name, std::string_view rating, int watched); // add a new movie to the table
+    bool increment_watched(std::string_view name);                               // increment watch count for a movie
+    void display(void) const;                                                    // same output as Movies::display
+
+    std::size_t size(void) const; // number of movies
+    Movie_row row(std::size_t row) const;
+
+    // aggregates over the columns
+    long long total_watched(void) const;                    // watches of every movie
+    long long total_watched(std::string_view rating) const; // watches of the movies with this rating
+    // watches per rating, in the order the ratings were first added
+    std::vector<std::pair<std::string, long long>> watched_by_rating(void) const;
+    // the k most watched movies with this rating, most watched first
+    std::vector<Movie_row> top_watched(std::size_t k, std::string_view rating) const;
+};
+} // namespace udemy1::s13c
+#endif // MOVIE_TABLE_HPP
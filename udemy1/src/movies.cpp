@@ -7,7 +7,13 @@
  ******************************************************************/
 #include "movies.hpp"
 
+#include "movies_file.hpp"
+
+#include <algorithm>
 #include <iostream>
+#include <limits>
+#include <omp.h>
+#include <utility>
 
 namespace udemy1::s13c
 {
@@ -15,8 +21,8 @@ namespace udemy1::s13c
 /**
  * @brief add_movie expects the name of the move, rating and watched count
  *
- * It will search the movies vector to see if a movie object already exists
- * with the same name.
+ * It will look up the name in the movie index to see if a movie object
+ * already exists with the same name.
  *
  * If it does then return false since the movie already exists
  * Otherwise, create a movie object from the provided information
@@ -24,19 +30,11 @@ namespace udemy1::s13c
  */
 bool Movies::add_movie(std::string name, std::string rating, int watched)
 {
+    // a single hash lookup both checks for the name and reserves its slot
+    if (!movieIndex.try_emplace(name, movieObject.size()).second)
+        return false;
 
-    for (const Movie& movie : movieObject)
-
-        if (movie.getName() == name)
-            return false;
-
-    Movie tmp{name, rating, watched};
-    movieObject.push_back(tmp);
-
-    // for(auto const i : movieObject)
-    //     if(i->getName() == name)
-    //         return false;
-    // movieObject.push_back(new Movie{name, rating, watched});
+    movieObject.emplace_back(std::move(name), std::move(rating), watched);
     return true;
 }
 
@@ -44,8 +42,8 @@ bool Movies::add_movie(std::string name, std::string rating, int watched)
  * @brief increment_watched expects the name of the move to increment the
  * watched count
  *
- * It will search the movies vector to see if a movie object already exists
- * with the same name.
+ * It will look up the name in the movie index to see if a movie object
+ * already exists with the same name.
  * If it does then increment that objects watched by 1 and return true.
  *
  * Otherwise, return false since then no movies object with the movie name
@@ -53,18 +51,107 @@ bool Movies::add_movie(std::string name, std::string rating, int watched)
  */
 bool Movies::increment_watched(std::string name)
 {
-    for (Movie& movie : movieObject)
-        if (movie.getName() == name) {
-            movie.increment_watched();
-            return true;
+    const auto found{movieIndex.find(name)};
+    if (found == movieIndex.end())
+        return false;
+
+    movieObject[found->second].increment_watched();
+    return true;
+}
+
+namespace
+{
+constexpr std::size_t least_events{4096}; // fewer events per thread are not worth one
+
+// a watched count that does not fit an int stops at its end
+int saturated(long watched)
+{
+    return static_cast<int>(
+        std::clamp<long>(watched, std::numeric_limits<int>::min(), std::numeric_limits<int>::max()));
+}
+} // namespace
+
+/**
+ * @brief add_watched expects a batch of (name, count) viewing events
+ *
+ * The events are split between the threads, at most one per least_events of them,
+ * and each thread looks the names up in the movie index. A batch about as large as
+ * the catalog is summed per movie in an array per thread, merged in one pass over the
+ * catalog. A smaller one keeps the (position, count) of each event it matched, those
+ * are sorted by position and summed, so the work follows the batch and not the catalog.
+ * The catalog is only written afterwards, so no locking is needed.
+ *
+ * Events whose name is not in the movies vector are skipped.
+ * Returns the number of events that matched a movie.
+ */
+std::size_t Movies::add_watched(std::span<const Watch_event> events, int threads)
+{
+    if (threads <= 0)
+        threads = omp_get_max_threads();
+    threads = static_cast<int>(
+        std::clamp<std::size_t>(events.size() / least_events, 1, static_cast<std::size_t>(threads)));
+    std::size_t applied{0};
+
+    if (events.size() < movieObject.size()) {
+        std::vector<std::vector<std::pair<std::size_t, long>>> partial(threads);
+#pragma omp parallel num_threads(threads) reduction(+ : applied)
+        {
+            std::vector<std::pair<std::size_t, long>>& local{partial[omp_get_thread_num()]};
+#pragma omp for schedule(static)
+            for (std::size_t i = 0; i < events.size(); ++i) {
+                const auto found{movieIndex.find(events[i].name)};
+                if (found != movieIndex.end()) {
+                    local.emplace_back(found->second, events[i].count);
+                    ++applied;
+                }
+            }
         }
 
-    // for(auto i : movieObject)
-    //     if(i->getName() == name) {
-    //         i->increment_watched();
-    //         return true;
-    //     }
-    return false;
+        std::vector<std::pair<std::size_t, long>> all;
+        all.reserve(applied);
+        for (const std::vector<std::pair<std::size_t, long>>& counts : partial)
+            all.insert(all.end(), counts.begin(), counts.end());
+        std::sort(all.begin(), all.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+        for (std::size_t i{0}; i < all.size();) {
+            const std::size_t position{all[i].first};
+            long count{movieObject[position].getWatched()};
+            for (; i < all.size() && all[i].first == position; ++i)
+                count += all[i].second;
+            movieObject[position].setWatched(saturated(count));
+        }
+        return applied;
+    }
+
+    // per thread count of watches for every movie position, a flat array is cheaper
+    // to update than a map once the batch is about as large as the catalog
+    std::vector<std::vector<long>> partial(threads);
+
+#pragma omp parallel num_threads(threads) reduction(+ : applied)
+    {
+        std::vector<long>& local{partial[omp_get_thread_num()]};
+        local.assign(movieObject.size(), 0);
+
+#pragma omp for schedule(static)
+        for (std::size_t i = 0; i < events.size(); ++i) {
+            const auto found{movieIndex.find(events[i].name)};
+            if (found != movieIndex.end()) {
+                local[found->second] += events[i].count;
+                ++applied;
+            }
+        }
+
+        // merge, every thread owns a range of movies so the writes never overlap
+#pragma omp for schedule(static)
+        for (std::size_t position = 0; position < movieObject.size(); ++position) {
+            long count{0};
+            for (const std::vector<long>& counts : partial)
+                if (!counts.empty()) // the runtime may start fewer threads than asked for
+                    count += counts[position];
+            if (count != 0)
+                movieObject[position].setWatched(saturated(movieObject[position].getWatched() + count));
+        }
+    }
+    return applied;
 }
 
 /**
@@ -89,6 +176,17 @@ void Movies::display(void) const
     }
 }
 
+/**
+ * @brief save writes the movies to a catalog file
+ *
+ * The file can be opened with Movies_file, which serves display and
+ * increment_watched from it without loading the movies back.
+ */
+bool Movies::save(const std::string& file_name) const
+{
+    return Movies_file::write(movieObject, file_name);
+}
+
 // constructor
 Movies::Movies() {}
 
@@ -5,6 +5,15 @@
  * Models a collection of Movie as a std::vector
  * implement these methods in Movies.cpp
  *
+ * A name -> position hash index is kept next to the vector,
+ * so add_movie and increment_watched do not scan the collection
+ *
+ * add_watched applies a batch of viewing events at once, the events are
+ * counted per title on several threads and then applied in one pass
+ *
+ * save writes the catalog as a file that Movies_file (movies_file.hpp)
+ * can use in place, without adding the movies again
+ *
  ******************************************************************/
 
 #ifndef MOVIES_HPP
@@ -12,15 +21,37 @@
 
 #include "movie.hpp"
 
+#include <cstddef>
+#include <functional>
+#include <span>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 #include <vector>
 
 namespace udemy1::s13c
 {
+// one viewing event, name must stay valid until the batch is applied
+struct Watch_event {
+    std::string_view name;
+    int count;
+};
+
 class Movies
 {
   private:
+    // lets the index be searched with a string_view, without building a std::string
+    struct Name_hash {
+        using is_transparent = void;
+        std::size_t operator()(std::string_view name) const
+        {
+            return std::hash<std::string_view>{}(name);
+        }
+    };
+
     std::vector<Movie> movieObject;
+    // name -> position in movieObject
+    std::unordered_map<std::string, std::size_t, Name_hash, std::equal_to<>> movieIndex;
     // std::vector<Movie*> movieObject;
 
     // Movie* find_movie(std::string name);
@@ -30,6 +61,12 @@ class Movies
     bool increment_watched(std::string name);                          // increment watch count for a movie
     void display(void) const;                                          // display the movieObject
 
+    // add the count of every event to its movie, events for unknown names are skipped
+    // threads = 0 uses the OpenMP default, returns the number of events applied
+    std::size_t add_watched(std::span<const Watch_event> events, int threads = 0);
+
+    bool save(const std::string& file_name) const; // write the catalog file, see Movies_file
+
     Movies();  // default constructor
     ~Movies(); // destructor
 };
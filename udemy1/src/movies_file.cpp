@@ -0,0 +1,323 @@
+/******************************************************************
+ * Section 13 Challenge
+ * movies_file.cpp
+ *
+ * A Movies catalog saved as a binary file, used in place through mmap
+ *
+ ******************************************************************/
+#include "movies_file.hpp"
+
+#include "movies.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <iostream>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <unordered_map>
+
+namespace udemy1::s13c
+{
+
+namespace
+{
+constexpr char file_magic[8]{'M', 'O', 'V', 'I', 'E', 'S', '\0', '\1'};
+
+/**
+ * @brief parse one CSV field starting at pos, pos is left after the separating comma
+ * a quoted field may hold commas, a doubled quote inside it stands for one quote
+ */
+bool next_field(const std::string& line, std::size_t& pos, std::string& field)
+{
+    field.clear();
+    if (pos > line.size())
+        return false; // the line ended before this field
+    if (pos < line.size() && line[pos] == '"') {
+        for (++pos; pos < line.size(); ++pos) {
+            if (line[pos] != '"')
+                field += line[pos];
+            else if (pos + 1 < line.size() && line[pos + 1] == '"')
+                field += line[++pos];
+            else
+                break;
+        }
+        if (pos++ >= line.size())
+            return false; // no closing quote
+    } else {
+        const std::size_t end{std::min(line.find(',', pos), line.size())};
+        field.assign(line, pos, end - pos);
+        pos = end;
+    }
+    if (pos < line.size() && line[pos] != ',')
+        return false;
+    ++pos;
+    return true;
+}
+} // namespace
+
+/**
+ * @brief FNV-1a, the index is stored in the file so the hash must not change
+ * between builds, which std::hash does not promise
+ */
+std::uint64_t Movies_file::hash(std::string_view name)
+{
+    std::uint64_t h{14695981039346656037ull};
+    for (const char c : name) {
+        h ^= static_cast<unsigned char>(c);
+        h *= 1099511628211ull;
+    }
+    return h;
+}
+
+/**
+ * @brief write the movies as a catalog file
+ *
+ * The records and the index are built in memory, the string pool is
+ * streamed out after them. Returns false when the file can not be written.
+ */
+bool Movies_file::write(const std::vector<Movie>& movies, const std::string& file_name)
+{
+    if (movies.size() >= UINT32_MAX) {
+        std::cerr << "Too many movies for a catalog file: " << movies.size() << std::endl;
+        return false;
+    }
+
+    // the ratings are stored once each at the start of the pool
+    std::unordered_map<std::string, std::uint32_t> rating_offsets;
+    std::string ratings;
+    for (const Movie& movie : movies)
+        if (rating_offsets.try_emplace(movie.getRating(), static_cast<std::uint32_t>(ratings.size())).second)
+            ratings += movie.getRating();
+
+    // at most two thirds full, the probes stay short
+    std::uint64_t bucket_count{2};
+    while (bucket_count < movies.size() + movies.size() / 2 + 1)
+        bucket_count *= 2;
+
+    std::vector<Record> records(movies.size());
+    std::vector<Slot> index(bucket_count, Slot{0, 0});
+    std::uint64_t pool_size{ratings.size()};
+    for (std::size_t i{0}; i < movies.size(); ++i) {
+        const Movie& movie{movies[i]};
+        records[i] = Record{pool_size, static_cast<std::uint32_t>(movie.getName().size()), movie.getWatched(),
+                            rating_offsets[movie.getRating()],
+                            static_cast<std::uint32_t>(movie.getRating().size())};
+        pool_size += movie.getName().size();
+
+        const std::uint64_t h{hash(movie.getName())};
+        std::uint64_t bucket{h & (bucket_count - 1)};
+        while (index[bucket].record != 0)
+            bucket = (bucket + 1) & (bucket_count - 1);
+        index[bucket] = Slot{static_cast<std::uint32_t>(i + 1), static_cast<std::uint32_t>(h >> 32)};
+    }
+
+    Header header{};
+    std::memcpy(header.magic, file_magic, sizeof file_magic);
+    header.count = movies.size();
+    header.bucket_count = bucket_count;
+    header.records_offset = sizeof(Header);
+    header.index_offset = header.records_offset + records.size() * sizeof(Record);
+    header.pool_offset = header.index_offset + index.size() * sizeof(Slot);
+    header.pool_size = pool_size;
+    header.file_size = header.pool_offset + pool_size;
+
+    std::ofstream ofs{file_name, std::ios::binary | std::ios::trunc};
+    if (!ofs) {
+        std::cerr << "File open error: " << file_name << std::endl;
+        return false;
+    }
+    ofs.write(reinterpret_cast<const char*>(&header), sizeof header);
+    ofs.write(reinterpret_cast<const char*>(records.data()), records.size() * sizeof(Record));
+    ofs.write(reinterpret_cast<const char*>(index.data()), index.size() * sizeof(Slot));
+    ofs.write(ratings.data(), ratings.size());
+    for (const Movie& movie : movies)
+        ofs.write(movie.getName().data(), movie.getName().size());
+    return static_cast<bool>(ofs.flush());
+}
+
+/**
+ * @brief map a catalog file, only the header is checked
+ *
+ * The file is mapped shared and writable, so increment_watched updates the file itself.
+ * On any error is_open() returns false and every query finds nothing.
+ */
+Movies_file::Movies_file(const std::string& file_name)
+    : map{nullptr}
+    , map_size{0}
+    , header{nullptr}
+    , records{nullptr}
+    , index{nullptr}
+    , pool{nullptr}
+{
+    const int fd{::open(file_name.c_str(), O_RDWR)};
+    if (fd < 0) {
+        std::cerr << "File open error: " << file_name << std::endl;
+        return;
+    }
+    struct stat st {};
+    if (::fstat(fd, &st) == 0 && static_cast<std::size_t>(st.st_size) >= sizeof(Header)) {
+        map_size = static_cast<std::size_t>(st.st_size);
+        map = ::mmap(nullptr, map_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+    ::close(fd);
+    if (map == nullptr || map == MAP_FAILED) {
+        map = nullptr;
+        std::cerr << "Not a movies file: " << file_name << std::endl;
+        return;
+    }
+
+    Header* const h{static_cast<Header*>(map)};
+    const bool valid{std::memcmp(h->magic, file_magic, sizeof file_magic) == 0 && h->file_size == map_size &&
+                     h->bucket_count != 0 && (h->bucket_count & (h->bucket_count - 1)) == 0 &&
+                     h->count < h->bucket_count && h->records_offset == sizeof(Header) &&
+                     h->index_offset == h->records_offset + h->count * sizeof(Record) &&
+                     h->pool_offset == h->index_offset + h->bucket_count * sizeof(Slot) &&
+                     h->pool_offset + h->pool_size == h->file_size};
+    if (!valid) {
+        std::cerr << "Not a movies file: " << file_name << std::endl;
+        ::munmap(map, map_size);
+        map = nullptr;
+        return;
+    }
+
+    char* const base{static_cast<char*>(map)};
+    header = h;
+    records = reinterpret_cast<Record*>(base + h->records_offset);
+    index = reinterpret_cast<const Slot*>(base + h->index_offset);
+    pool = base + h->pool_offset;
+}
+
+Movies_file::~Movies_file()
+{
+    if (map != nullptr)
+        ::munmap(map, map_size);
+}
+
+bool Movies_file::is_open(void) const
+{
+    return header != nullptr;
+}
+
+std::size_t Movies_file::size(void) const
+{
+    return is_open() ? header->count : 0;
+}
+
+/**
+ * @brief a string from the pool, empty when the record points outside of it
+ */
+std::string_view Movies_file::text(std::uint64_t offset, std::uint32_t length) const
+{
+    if (offset > header->pool_size || length > header->pool_size - offset)
+        return {};
+    return {pool + offset, length};
+}
+
+Movies_file::Record* Movies_file::find(std::string_view name) const
+{
+    if (!is_open())
+        return nullptr;
+
+    const std::uint64_t h{hash(name)};
+    const std::uint32_t tag{static_cast<std::uint32_t>(h >> 32)};
+    const std::uint64_t mask{header->bucket_count - 1};
+    // write() always leaves an empty slot, a damaged file may have none
+    std::uint64_t bucket{h & mask};
+    for (std::uint64_t probe{0}; probe < header->bucket_count; ++probe, bucket = (bucket + 1) & mask) {
+        const Slot slot{index[bucket]};
+        if (slot.record == 0 || slot.record > header->count)
+            return nullptr;
+        Record& record{records[slot.record - 1]};
+        if (slot.tag == tag && text(record.name_offset, record.name_length) == name)
+            return &record;
+    }
+    return nullptr;
+}
+
+/**
+ * @brief increment_watched expects the name of the move to increment the
+ * watched count, the count is changed in the mapped file
+ *
+ * Returns false when no movie with that name is in the file
+ */
+bool Movies_file::increment_watched(std::string_view name)
+{
+    Record* const record{find(name)};
+    if (record == nullptr)
+        return false;
+    ++record->watched;
+    return true;
+}
+
+bool Movies_file::get_watched(std::string_view name, int& watched) const
+{
+    const Record* const record{find(name)};
+    if (record == nullptr)
+        return false;
+    watched = record->watched;
+    return true;
+}
+
+/**
+ * @brief display all the movies of the file, in the order they were added,
+ * byte for byte what Movies::display prints for the same catalog
+ */
+void Movies_file::display(void) const
+{
+    if (size() == 0) {
+        std::cout << "Sorry, no movies to display" << std::endl << std::endl;
+        return;
+    }
+
+    std::cout << std::endl << "===================================" << std::endl;
+    for (std::uint64_t i{0}; i < header->count; ++i) {
+        const Record& record{records[i]};
+        std::cout << text(record.name_offset, record.name_length) << ", "
+                  << text(record.rating_offset, record.rating_length) << ", " << record.watched << '\n';
+    }
+    std::cout << "===================================" << std::endl << std::endl;
+}
+
+/**
+ * @brief convert a CSV of name,rating,watched lines to a catalog file
+ *
+ * The lines go through Movies::add_movie, so a repeated name keeps its first line.
+ * Returns false, after reporting the line, when a line can not be read.
+ */
+bool csv_to_movies_file(const std::string& csv_name, const std::string& file_name)
+{
+    std::ifstream ifs{csv_name};
+    if (!ifs) {
+        std::cerr << "File open error: " << csv_name << std::endl;
+        return false;
+    }
+
+    Movies movies;
+    std::string line, name, rating, watched;
+    for (std::size_t line_number{1}; std::getline(ifs, line); ++line_number) {
+        if (!line.empty() && line.back() == '\r')
+            line.pop_back();
+        if (line.empty() || (line_number == 1 && line == "name,rating,watched"))
+            continue;
+
+        std::size_t pos{0};
+        int count{0};
+        const bool valid{next_field(line, pos, name) && next_field(line, pos, rating) &&
+                         next_field(line, pos, watched) && pos > line.size() &&
+                         std::from_chars(watched.data(), watched.data() + watched.size(), count).ptr ==
+                             watched.data() + watched.size() &&
+                         !watched.empty()};
+        if (!valid) {
+            std::cerr << csv_name << ":" << line_number << ": expected name,rating,watched: " << line << std::endl;
+            return false;
+        }
+        movies.add_movie(name, rating, count);
+    }
+    return movies.save(file_name);
+}
+
+} // namespace udemy1::s13c
@@ -0,0 +1,91 @@
+/******************************************************************
+ * Section 13 Challenge
+ * movies_file.hpp
+ *
+ * A Movies catalog saved as a binary file, used in place through mmap
+ *
+ * File layout, integers in the native byte order:
+ *   Header
+ *   Record[count]        one per movie, in the order they were added
+ *   Slot[bucket_count]   hash index over the names, linear probing
+ *   string pool          the ratings first (each stored once), then the names
+ *
+ * Opening a file maps it and checks the header, nothing is parsed,
+ * so the cost does not grow with the number of movies.
+ ******************************************************************/
+
+#ifndef MOVIES_FILE_HPP
+#define MOVIES_FILE_HPP
+
+#include "movie.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace udemy1::s13c
+{
+class Movies_file
+{
+  private:
+    struct Header {
+        char magic[8];              // "MOVIES" 0 and the format version
+        std::uint64_t count;        // number of records
+        std::uint64_t bucket_count; // number of index slots, a power of two
+        std::uint64_t records_offset;
+        std::uint64_t index_offset;
+        std::uint64_t pool_offset;
+        std::uint64_t pool_size;
+        std::uint64_t file_size;
+    };
+
+    struct Record {
+        std::uint64_t name_offset;   // into the string pool
+        std::uint32_t name_length;
+        std::int32_t watched;        // updated in place by increment_watched
+        std::uint32_t rating_offset; // the ratings come first in the pool, 32 bits are enough
+        std::uint32_t rating_length;
+    };
+
+    struct Slot {
+        std::uint32_t record; // record number + 1, 0 for an empty slot
+        std::uint32_t tag;    // upper half of the name hash, skips most string compares
+    };
+
+    void* map;
+    std::size_t map_size;
+    Header* header;
+    Record* records;
+    const Slot* index;
+    const char* pool;
+
+    static std::uint64_t hash(std::string_view name);
+    std::string_view text(std::uint64_t offset, std::uint32_t length) const;
+    Record* find(std::string_view name) const;
+
+  public:
+    explicit Movies_file(const std::string& file_name); // map the file read/write
+    ~Movies_file();                                     // unmap, the increments are kept in the file
+    Movies_file(const Movies_file&) = delete;
+    Movies_file& operator=(const Movies_file&) = delete;
+
+    bool is_open(void) const;     // false when the file is missing or not a catalog file
+    std::size_t size(void) const; // number of movies
+
+    bool increment_watched(std::string_view name);               // increment watch count for a movie, in the file
+    bool get_watched(std::string_view name, int& watched) const; // watch count for a movie
+    void display(void) const;                                    // same output as Movies::display
+
+    // write the movies as a catalog file, used by Movies::save
+    static bool write(const std::vector<Movie>& movies, const std::string& file_name);
+};
+
+// read a CSV of name,rating,watched lines and save it as a catalog file
+// names may be quoted ("The Good, the Bad and the Ugly"), a name,rating,watched
+// header line is skipped, repeated names keep the first line like Movies::add_movie
+bool csv_to_movies_file(const std::string& csv_name, const std::string& file_name);
+
+} // namespace udemy1::s13c
+#endif // MOVIES_FILE_HPP
@@ -1,18 +1,161 @@
 #include "mystring.hpp"
 
+#include "mystring_simd.hpp"
+
+#include <algorithm>
+#include <cstdint>
 #include <cstring>
+#include <utility>
 
 namespace udemy1::myclass
 {
 
+namespace
+{
+// string_view of a C-style string, nullptr is treated as "" like the arg constructor does
+std::string_view as_view(const char* s)
+{
+    return (s == nullptr) ? std::string_view{} : std::string_view{s};
+}
+} // namespace
+
+/**
+ * @brief check if the string lives in the inline buffer
+ */
+bool Mystring::is_small(void) const
+{
+    return this->str == this->sso_buff;
+}
+
+/**
+ * @brief free the heap buffer, if any, and reset to an empty small string
+ */
+void Mystring::release(void)
+{
+    if (!is_small())
+        delete[] this->str;
+    this->str = this->sso_buff;
+    this->size = 0;
+    this->capacity = sso_capacity;
+    this->sso_buff[0] = '\0';
+}
+
+/**
+ * @brief copy the first chars of a heap string into sso_buff
+ *
+ * sso_buff is unused once the string moves to the heap, keeping its first
+ * chars there lets compare() settle most orderings without touching the heap.
+ */
+void Mystring::sync_prefix(void)
+{
+    if (!is_small())
+        std::memcpy(this->sso_buff, this->str, std::min(this->size, sso_capacity));
+}
+
+/**
+ * @brief three way compare, the inline prefix first and the heap only for ties
+ * @param rhs
+ */
+int Mystring::compare(const Mystring& rhs) const
+{
+    const std::size_t n{std::min({this->size, rhs.size, sso_capacity})};
+    const int prefix{simd::compare(this->sso_buff, n, rhs.sso_buff, n)};
+    if (prefix != 0)
+        return prefix;
+    if (n < sso_capacity) // the shorter string fits in the prefix, so the length decides
+        return (this->size < rhs.size) ? -1 : (this->size > rhs.size);
+    return simd::compare(this->str + n, this->size - n, rhs.str + n, rhs.size - n);
+}
+
+/**
+ * @brief make sure the buffer can hold n chars (plus the '\0'), content is kept
+ * @param n
+ */
+void Mystring::grow(std::size_t n)
+{
+    if (n <= this->capacity)
+        return;
+
+    char* buff = new char[n + 1];
+    std::memcpy(buff, this->str, this->size + 1);
+    if (!is_small())
+        delete[] this->str;
+    this->str = buff;
+    this->capacity = n;
+}
+
+/**
+ * @brief replace the content with n chars starting at s, s may point into this string
+ * @param s
+ * @param n
+ */
+void Mystring::assign(const char* s, std::size_t n)
+{
+    if (n > this->capacity) {
+        char* buff = new char[n + 1];
+        std::memcpy(buff, s, n);
+        if (!is_small())
+            delete[] this->str;
+        this->str = buff;
+        this->capacity = n;
+    } else
+        std::memmove(this->str, s, n);
+
+    this->str[n] = '\0';
+    this->size = n;
+    sync_prefix();
+}
+
+/**
+ * @brief add n chars starting at s to the end, s may point into this string
+ *
+ * The buffer at least doubles when it has to grow so a run of appends costs
+ * amortised O(1) per char instead of copying the whole string every time.
+ * @param s
+ * @param n
+ */
+void Mystring::append(const char* s, std::size_t n)
+{
+    const std::size_t new_size{this->size + n};
+    if (new_size > this->capacity) {
+        const bool aliased{s >= this->str && s <= this->str + this->size};
+        const std::size_t offset{aliased ? static_cast<std::size_t>(s - this->str) : 0};
+        grow(std::max(new_size, 2 * this->capacity));
+        if (aliased)
+            s = this->str + offset;
+    }
+    const bool prefix_changed{this->size < sso_capacity};
+    std::memmove(this->str + this->size, s, n);
+    this->size = new_size;
+    this->str[new_size] = '\0';
+    if (prefix_changed)
+        sync_prefix();
+}
+
+std::size_t Mystring::length_of(const Mystring& s)
+{
+    return s.size;
+}
+
+std::size_t Mystring::length_of(const char* s)
+{
+    return (s == nullptr) ? 0 : std::strlen(s);
+}
+
+std::size_t Mystring::length_of(std::string_view s)
+{
+    return s.size();
+}
+
 /**
  * @brief Mystring - Default constructor
  */
 Mystring::Mystring()
-    : str{nullptr}
+    : str{sso_buff}
+    , size{0}
+    , capacity{sso_capacity}
+    , sso_buff{}
 {
-    this->str = new char[1];
-    *this->str = '\0';
 }
 
 /**
@@ -20,15 +163,20 @@ Mystring::Mystring()
  * @param src
  */
 Mystring::Mystring(const char* s)
-    : str{nullptr}
-{
-    if (s == nullptr) {
-        this->str = new char[1];
-        *this->str = '\0';
-    } else {
-        this->str = new char[std::strlen(s) + 1];
-        std::strcpy(this->str, s);
-    }
+    : Mystring{}
+{
+    if (s != nullptr)
+        assign(s, std::strlen(s));
+}
+
+/**
+ * @brief Mystring - string_view constructor
+ * @param s
+ */
+Mystring::Mystring(std::string_view s)
+    : Mystring{}
+{
+    assign(s.data(), s.size());
 }
 
 /**
@@ -36,10 +184,9 @@ Mystring::Mystring(const char* s)
  * @param src
  */
 Mystring::Mystring(const Mystring& src)
-    : str{nullptr}
+    : Mystring{}
 {
-    this->str = new char[std::strlen(src.str) + 1];
-    std::strcpy(this->str, src.str);
+    assign(src.str, src.size);
 }
 
 /**
@@ -47,10 +194,9 @@ Mystring::Mystring(const Mystring& src)
  * @param src
  */
 Mystring::Mystring(Mystring&& src) noexcept
-    : str{nullptr}
+    : Mystring{}
 {
-    this->str = src.str;
-    src.str = nullptr;
+    *this = std::move(src);
 }
 
 /**
@@ -58,7 +204,8 @@ Mystring::Mystring(Mystring&& src) noexcept
  */
 Mystring::~Mystring()
 {
-    delete[] str;
+    if (!is_small())
+        delete[] str;
 }
 
 /**
@@ -69,10 +216,7 @@ Mystring& Mystring::operator=(const Mystring& src)
     if (this == &src)
         return *this;
 
-    delete[] this->str;
-
-    this->str = new char[std::strlen(src.str) + 1];
-    std::strcpy(this->str, src.str);
+    assign(src.str, src.size); // reuses the current buffer when it is big enough
 
     return *this;
 }
@@ -85,10 +229,18 @@ Mystring& Mystring::operator=(Mystring&& src) noexcept
     if (this == &src)
         return *this;
 
-    delete[] this->str;
+    release();
 
-    this->str = src.str;
-    src.str = nullptr;
+    std::memcpy(this->sso_buff, src.sso_buff, sizeof(this->sso_buff)); // the string or its prefix
+    if (src.is_small())
+        this->size = src.size;
+    else {
+        this->str = src.str;
+        this->size = src.size;
+        this->capacity = src.capacity;
+        src.str = src.sso_buff; // leave the source as a valid empty string
+    }
+    src.release();
 
     return *this;
 }
@@ -106,7 +258,7 @@ void Mystring::display(void)
  */
 int Mystring::getLength() const
 {
-    return std::strlen(this->str);
+    return static_cast<int>(this->size);
 }
 
 /**
@@ -117,6 +269,99 @@ const char* Mystring::getStr(void) const
     return this->str;
 }
 
+/**
+ * @brief view of the chars, valid until the string is next modified
+ */
+Mystring::operator std::string_view() const noexcept
+{
+    return std::string_view{this->str, this->size};
+}
+
+/**
+ * @brief hash the chars 8 bytes at a time (MurmurHash64A mixing)
+ *
+ * Quick and well spread for map keys, not meant for untrusted input.
+ * @param s
+ */
+std::size_t Mystring::hash(std::string_view s) noexcept
+{
+    constexpr std::uint64_t m{0xc6a4a7935bd1e995ULL};
+    constexpr int r{47};
+
+    const char* p{s.data()};
+    std::size_t n{s.size()};
+    std::uint64_t h{0x9e3779b97f4a7c15ULL ^ (n * m)};
+
+    for (; n >= 8; p += 8, n -= 8) {
+        std::uint64_t k;
+        std::memcpy(&k, p, 8);
+        k *= m;
+        k ^= k >> r;
+        k *= m;
+        h ^= k;
+        h *= m;
+    }
+    if (n > 0) {
+        std::uint64_t k{0};
+        std::memcpy(&k, p, n);
+        h ^= k;
+        h *= m;
+    }
+
+    h ^= h >> r;
+    h *= m;
+    h ^= h >> r;
+    return static_cast<std::size_t>(h);
+}
+
+/**
+ * @brief number of chars the string can hold before it needs to allocate
+ */
+std::size_t Mystring::getCapacity(void) const
+{
+    return this->capacity;
+}
+
+/**
+ * @brief allocate room for at least n chars, never shrinks
+ * @param n
+ */
+void Mystring::reserve(std::size_t n)
+{
+    grow(n);
+}
+
+/**
+ * @brief append rhs to the end of this string
+ * @param rhs
+ */
+Mystring& Mystring::append(const Mystring& rhs)
+{
+    append(rhs.str, rhs.size);
+    return *this;
+}
+
+/**
+ * @brief append a C-style string to the end of this string
+ * @param s
+ */
+Mystring& Mystring::append(const char* s)
+{
+    if (s != nullptr)
+        append(s, std::strlen(s));
+    return *this;
+}
+
+/**
+ * @brief append the chars of a string_view to the end of this string
+ * @param s
+ */
+Mystring& Mystring::append(std::string_view s)
+{
+    append(s.data(), s.size());
+    return *this;
+}
+
 std::ostream& operator<<(std::ostream& os, const Mystring& rhs)
 {
     os << rhs.str;
@@ -129,7 +374,7 @@ std::ostream& operator<<(std::ostream& os, const Mystring& rhs)
  */
 bool Mystring::operator==(const Mystring& rhs) const
 {
-    return (std::strcmp(this->str, rhs.str) == 0);
+    return (this->size == rhs.size) && (compare(rhs) == 0);
 }
 
 /**
@@ -147,7 +392,7 @@ bool Mystring::operator!=(const Mystring& rhs) const
  */
 bool Mystring::operator<(const Mystring& rhs) const
 {
-    return (std::strcmp(this->str, rhs.str) < 0);
+    return (compare(rhs) < 0);
 }
 
 /**
@@ -156,20 +401,61 @@ bool Mystring::operator<(const Mystring& rhs) const
  */
 bool Mystring::operator>(const Mystring& rhs) const
 {
-    return (std::strcmp(this->str, rhs.str) > 0);
+    return (compare(rhs) > 0);
 }
 
 /**
- * @brief Unary minus operator overloading
+ * @brief Binary equals operator overloading, plain text on the rhs
+ * @param rhs
  */
-Mystring Mystring::operator-() const
+bool Mystring::operator==(std::string_view rhs) const
+{
+    return (this->size == rhs.size()) && (simd::compare(this->str, this->size, rhs.data(), rhs.size()) == 0);
+}
+
+bool Mystring::operator!=(std::string_view rhs) const
+{
+    return !(*this == rhs);
+}
+
+bool Mystring::operator<(std::string_view rhs) const
 {
-    Mystring tmp{this->str};
-    size_t s = this->getLength();
+    return (simd::compare(this->str, this->size, rhs.data(), rhs.size()) < 0);
+}
 
-    for (size_t i{0}; i < s; ++i)
-        tmp.str[i] = std::tolower(tmp.str[i]);
+bool Mystring::operator>(std::string_view rhs) const
+{
+    return (simd::compare(this->str, this->size, rhs.data(), rhs.size()) > 0);
+}
 
+bool Mystring::operator==(const char* rhs) const
+{
+    return *this == as_view(rhs);
+}
+
+bool Mystring::operator!=(const char* rhs) const
+{
+    return !(*this == as_view(rhs));
+}
+
+bool Mystring::operator<(const char* rhs) const
+{
+    return *this < as_view(rhs);
+}
+
+bool Mystring::operator>(const char* rhs) const
+{
+    return *this > as_view(rhs);
+}
+
+/**
+ * @brief Unary minus operator overloading
+ */
+Mystring Mystring::operator-() const
+{
+    Mystring tmp{*this};
+    simd::flip_case(tmp.str, tmp.size, 'A'); // ASCII tolower, 16/32 chars at a time
+    tmp.sync_prefix();
     return tmp;
 }
 
@@ -177,16 +463,28 @@ Mystring Mystring::operator-() const
  * @brief Binary plus operator overloading
  * @param rhs
  */
-Mystring Mystring::operator+(const Mystring& rhs) const
+Mystring Mystring::operator+(const Mystring& rhs) const&
 {
-    char* buff = new char[std::strlen(this->str) + std::strlen(rhs.str) + 1];
-    std::strcpy(buff, this->str);
-    std::strcat(buff, rhs.str);
-    Mystring tmp{buff};
-    delete[] buff;
+    Mystring tmp;
+    tmp.reserve(this->size + rhs.size);
+    tmp.append(this->str, this->size);
+    tmp.append(rhs.str, rhs.size);
     return tmp;
 }
 
+/**
+ * @brief Binary plus operator overloading on a temporary lhs
+ *
+ * Chains such as a + b + c reuse the buffer of the intermediate result
+ * instead of building a new string for every '+'.
+ * @param rhs
+ */
+Mystring Mystring::operator+(const Mystring& rhs) &&
+{
+    append(rhs.str, rhs.size);
+    return std::move(*this);
+}
+
 /**
  * @brief Binary multiply operator overloading
  * @param n
@@ -194,8 +492,12 @@ Mystring Mystring::operator+(const Mystring& rhs) const
 Mystring Mystring::operator*(const int n) const
 {
     Mystring tmp;
+    if (n <= 0)
+        return tmp;
+
+    tmp.reserve(this->size * n);
     for (int i{1}; i <= n; ++i)
-        tmp = tmp + *this;
+        tmp.append(this->str, this->size);
     return tmp;
 }
 
@@ -204,9 +506,8 @@ Mystring Mystring::operator*(const int n) const
  */
 Mystring& Mystring::operator++()
 {
-    size_t s = this->getLength();
-    for (size_t i{0}; i < s; ++i)
-        this->str[i] = std::toupper(this->str[i]);
+    simd::flip_case(this->str, this->size, 'a'); // ASCII toupper, 16/32 chars at a time
+    sync_prefix();
     return *this;
 }
 
@@ -226,8 +527,7 @@ Mystring Mystring::operator++(int)
  */
 Mystring& Mystring::operator+=(const Mystring& rhs)
 {
-    *this = *this + rhs;
-    return *this;
+    return append(rhs);
 }
 
 /**
@@ -236,7 +536,16 @@ Mystring& Mystring::operator+=(const Mystring& rhs)
  */
 Mystring& Mystring::operator*=(const int rhs)
 {
-    *this = *this * rhs;
+    if (rhs <= 0) {
+        assign("", 0);
+        return *this;
+    }
+
+    // one allocation, then keep doubling the copied block until it reaches the full length
+    const std::size_t total{this->size * rhs};
+    reserve(total);
+    while (this->size < total)
+        append(this->str, std::min(this->size, total - this->size));
     return *this;
 }
 } // namespace udemy1::myclass
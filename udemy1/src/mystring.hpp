@@ -1,7 +1,13 @@
 #ifndef MYSTRING_HPP
 #define MYSTRING_HPP
 
+#include <cstddef>
+#include <functional>
 #include <iostream>
+#include <iterator>
+#include <memory>
+#include <string_view>
+#include <type_traits>
 
 namespace udemy1::myclass
 {
@@ -12,10 +18,32 @@ class Mystring
     friend std::ostream& operator>>(std::istream& is, Mystring& rhs);
 
   private:
-    char* str; // pointer to a char[] that holds a C-style string
+    static constexpr std::size_t sso_capacity = 15; // longest string stored without a heap allocation
+
+    char* str;                       // pointer to a char[] that holds a C-style string, sso_buff or heap
+    std::size_t size;                // cached string length, excluding the '\0'
+    std::size_t capacity;            // chars str can hold, excluding the '\0'
+    char sso_buff[sso_capacity + 1]; // inline buffer while short, copy of the first chars once on the heap
+
+    bool is_small(void) const; // true while str points to sso_buff
+    void release(void);        // free the heap buffer (if any) and go back to an empty small string
+    void grow(std::size_t n);  // make room for n chars, keeps the current content
+    void assign(const char* s, std::size_t n); // replace content with the n chars at s
+    void append(const char* s, std::size_t n); // add the n chars at s, grows geometrically
+    void sync_prefix(void);                    // refresh the inline prefix after the heap chars changed
+    int compare(const Mystring& rhs) const;    // three way compare, same order as std::strcmp
+
+    static std::size_t length_of(const Mystring& s);  // length of a concat() part
+    static std::size_t length_of(const char* s);      // length of a concat() part
+    static std::size_t length_of(std::string_view s); // length of a concat() part
+
   public:
     Mystring();                        // default constructor
     Mystring(const char* s);           // arg constructor
+    Mystring(std::string_view s);      // arg constructor, copies exactly s.size() chars
+
+    template <std::input_iterator It>
+    Mystring(It first, It last); // range constructor
     Mystring(const Mystring& src);     // copy constructor
     Mystring(Mystring&& src) noexcept; // move constructor
     ~Mystring();                       // destructor
@@ -27,6 +55,20 @@ class Mystring
     int getLength() const;          // get string length
     const char* getStr(void) const; // getstring
 
+    operator std::string_view() const noexcept; // read only view, no copy
+
+    static std::size_t hash(std::string_view s) noexcept; // fast non-cryptographic hash, see std::hash below
+
+    std::size_t getCapacity(void) const;  // chars that fit without a new allocation
+    void reserve(std::size_t n);          // allocate room for n chars up front
+    Mystring& append(const Mystring& rhs); // in place concatenation, amortised O(rhs length)
+    Mystring& append(const char* s);       // in place concatenation, amortised O(strlen(s))
+    Mystring& append(std::string_view s);  // in place concatenation, amortised O(s.size())
+
+    // build a string from several parts (Mystring, const char* or string_view) with a single allocation
+    template <typename... Parts>
+    static Mystring concat(const Parts&... parts);
+
     Mystring operator-() const; // unary minus operator overloading
     Mystring& operator++();     // pre increment operator overloading
     Mystring operator++(int);   // post increment operator overloading
@@ -36,13 +78,86 @@ class Mystring
     bool operator<(const Mystring& rhs) const;  // Binary less than operator overloading
     bool operator>(const Mystring& rhs) const;  // Binary greater than operator overloading
 
-    Mystring operator+(const Mystring& rhs) const; // Binary plus operator overloading
-    Mystring operator*(const int rhs) const;       // Binary multiply operator overloading
+    // comparisons against plain text, no temporary Mystring is built
+    bool operator==(std::string_view rhs) const;
+    bool operator!=(std::string_view rhs) const;
+    bool operator<(std::string_view rhs) const;
+    bool operator>(std::string_view rhs) const;
+    bool operator==(const char* rhs) const;
+    bool operator!=(const char* rhs) const;
+    bool operator<(const char* rhs) const;
+    bool operator>(const char* rhs) const;
+
+    Mystring operator+(const Mystring& rhs) const&; // Binary plus operator overloading
+    Mystring operator+(const Mystring& rhs) &&;     // Binary plus on a temporary, appends in place
+    Mystring operator*(const int rhs) const;        // Binary multiply operator overloading
 
     Mystring& operator+=(const Mystring& rhs); // Binary plus-equal operator overloading
     Mystring& operator*=(const int rhs);       // Binary multiply-equal operator overloading
 };
 
+/**
+ * @brief Concatenate all the parts into one new string, sizing the buffer once
+ *        ex.) Mystring::concat(first, " ", last)
+ */
+template <typename... Parts>
+Mystring Mystring::concat(const Parts&... parts)
+{
+    Mystring tmp;
+    tmp.reserve((length_of(parts) + ... + 0));
+    (tmp.append(parts), ...);
+    return tmp;
+}
+
+/**
+ * @brief Range constructor, copies the chars in [first, last)
+ */
+template <std::input_iterator It>
+Mystring::Mystring(It first, It last)
+    : Mystring{}
+{
+    if constexpr (std::contiguous_iterator<It>)
+        append(std::to_address(first), static_cast<std::size_t>(last - first));
+    else {
+        if constexpr (std::forward_iterator<It>)
+            reserve(static_cast<std::size_t>(std::distance(first, last)));
+        for (; first != last; ++first) {
+            const char c = *first;
+            append(&c, 1);
+        }
+    }
+}
+
 } // namespace udemy1::myclass
 
+/**
+ * @brief Hash and equality for the unordered containers
+ *
+ * Both are transparent, so an std::unordered_map<Mystring, T> can be probed
+ * with a std::string_view or a const char* without building a Mystring.
+ */
+template <>
+struct std::hash<udemy1::myclass::Mystring> {
+    using is_transparent = void;
+
+    std::size_t operator()(std::string_view s) const noexcept
+    {
+        return udemy1::myclass::Mystring::hash(s);
+    }
+};
+
+template <>
+struct std::equal_to<udemy1::myclass::Mystring> {
+    using is_transparent = void;
+
+    template <typename Lhs, typename Rhs>
+    bool operator()(const Lhs& lhs, const Rhs& rhs) const
+    {
+        if constexpr (std::is_same_v<Lhs, udemy1::myclass::Mystring>)
+            return lhs == rhs;
+        else
+            return rhs == lhs;
+    }
+};
+
 #endif // MYSTRING_HPP
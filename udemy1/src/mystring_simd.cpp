@@ -0,0 +1,234 @@
+#include "mystring_simd.hpp"
+
+#if defined(__x86_64__) || defined(__i386__)
+#define MYSTRING_SIMD_X86 1
+#include <immintrin.h>
+#endif
+
+namespace udemy1::myclass::simd
+{
+
+namespace
+{
+//------------------------------------------------------------------------------------
+// Scalar kernels, also used for the tail left over by the vector loops
+
+void flip_case_scalar(char* s, std::size_t n, char first)
+{
+    for (std::size_t i{0}; i < n; ++i)
+        if (static_cast<unsigned char>(s[i] - first) < 26)
+            s[i] ^= 0x20;
+}
+
+int compare_tail(const char* lhs, std::size_t lhs_n, const char* rhs, std::size_t rhs_n, std::size_t i)
+{
+    const std::size_t n{lhs_n < rhs_n ? lhs_n : rhs_n};
+    for (; i < n; ++i)
+        if (lhs[i] != rhs[i])
+            return static_cast<unsigned char>(lhs[i]) - static_cast<unsigned char>(rhs[i]);
+    return (lhs_n < rhs_n) ? -1 : (lhs_n > rhs_n);
+}
+
+#ifdef MYSTRING_SIMD_X86
+//------------------------------------------------------------------------------------
+// SSE2 kernels, 16 bytes per step
+//
+// The case range test moves [first, first + 26) down to [-128, -102) with a wrapping add,
+// so a single signed compare tells if a byte is inside the range.
+
+[[gnu::target("sse2")]] std::size_t flip_case_sse2(char* s, std::size_t n, char first)
+{
+    const __m128i bias = _mm_set1_epi8(static_cast<char>(128 - first));
+    const __m128i limit = _mm_set1_epi8(static_cast<char>(-128 + 26));
+    const __m128i flip = _mm_set1_epi8(0x20);
+
+    std::size_t i{0};
+    for (; i + 16 <= n; i += 16) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i));
+        const __m128i in_range = _mm_cmplt_epi8(_mm_add_epi8(v, bias), limit);
+        v = _mm_xor_si128(v, _mm_and_si128(in_range, flip));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(s + i), v);
+    }
+    return i;
+}
+
+[[gnu::target("sse2")]] int compare_sse2(const char* lhs, std::size_t lhs_n, const char* rhs, std::size_t rhs_n)
+{
+    const std::size_t n{lhs_n < rhs_n ? lhs_n : rhs_n};
+    std::size_t i{0};
+    for (; i + 16 <= n; i += 16) {
+        const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(lhs + i));
+        const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rhs + i));
+        const unsigned equal = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(a, b)));
+        if (equal != 0xFFFFu) {
+            i += __builtin_ctz(~equal);
+            return static_cast<unsigned char>(lhs[i]) - static_cast<unsigned char>(rhs[i]);
+        }
+    }
+    return compare_tail(lhs, lhs_n, rhs, rhs_n, i);
+}
+
+//------------------------------------------------------------------------------------
+// AVX2 kernels, 32 bytes per step, the remainder goes through SSE2 and then scalar
+
+[[gnu::target("avx2")]] std::size_t flip_case_avx2(char* s, std::size_t n, char first)
+{
+    const __m256i bias = _mm256_set1_epi8(static_cast<char>(128 - first));
+    const __m256i limit = _mm256_set1_epi8(static_cast<char>(-128 + 26));
+    const __m256i flip = _mm256_set1_epi8(0x20);
+
+    std::size_t i{0};
+    for (; i + 32 <= n; i += 32) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + i));
+        const __m256i in_range = _mm256_cmpgt_epi8(limit, _mm256_add_epi8(v, bias));
+        v = _mm256_xor_si256(v, _mm256_and_si256(in_range, flip));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(s + i), v);
+    }
+    return i + flip_case_sse2(s + i, n - i, first);
+}
+
+[[gnu::target("avx2")]] int compare_avx2(const char* lhs, std::size_t lhs_n, const char* rhs, std::size_t rhs_n)
+{
+    const std::size_t n{lhs_n < rhs_n ? lhs_n : rhs_n};
+    std::size_t i{0};
+    for (; i + 32 <= n; i += 32) {
+        const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(lhs + i));
+        const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rhs + i));
+        const unsigned equal = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(a, b)));
+        if (equal != 0xFFFFFFFFu) {
+            i += __builtin_ctz(~equal);
+            return static_cast<unsigned char>(lhs[i]) - static_cast<unsigned char>(rhs[i]);
+        }
+    }
+    return compare_sse2(lhs + i, lhs_n - i, rhs + i, rhs_n - i);
+}
+#endif // MYSTRING_SIMD_X86
+
+// run a kernel at a level that is known to be supported
+void flip_case_with(Level level, char* s, std::size_t n, char first)
+{
+    std::size_t done{0};
+#ifdef MYSTRING_SIMD_X86
+    switch (level) {
+    case Level::avx2: done = flip_case_avx2(s, n, first); break;
+    case Level::sse2: done = flip_case_sse2(s, n, first); break;
+    default: break;
+    }
+#else
+    (void)level;
+#endif
+    flip_case_scalar(s + done, n - done, first);
+}
+
+int compare_with(Level level, const char* lhs, std::size_t lhs_n, const char* rhs, std::size_t rhs_n)
+{
+#ifdef MYSTRING_SIMD_X86
+    switch (level) {
+    case Level::avx2: return compare_avx2(lhs, lhs_n, rhs, rhs_n);
+    case Level::sse2: return compare_sse2(lhs, lhs_n, rhs, rhs_n);
+    default: break;
+    }
+#else
+    (void)level;
+#endif
+    return compare_tail(lhs, lhs_n, rhs, rhs_n, 0);
+}
+
+Level detect_level(void)
+{
+#ifdef MYSTRING_SIMD_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+        return Level::avx2;
+    if (__builtin_cpu_supports("sse2"))
+        return Level::sse2;
+#endif
+    return Level::scalar;
+}
+
+Level usable(Level level)
+{
+    const Level best{best_level()};
+    return (level < best) ? level : best;
+}
+
+template <Level level>
+void flip_case_at(char* s, std::size_t n, char first)
+{
+    flip_case_with(level, s, n, first);
+}
+
+template <Level level>
+int compare_at(const char* lhs, std::size_t lhs_n, const char* rhs, std::size_t rhs_n)
+{
+    return compare_with(level, lhs, lhs_n, rhs, rhs_n);
+}
+
+// kernels picked once, on the first call, the hot calls after it skip the level checks
+using flip_case_fn = void (*)(char*, std::size_t, char);
+using compare_fn = int (*)(const char*, std::size_t, const char*, std::size_t);
+
+flip_case_fn best_flip_case(void)
+{
+    static const flip_case_fn fn{[] {
+        switch (best_level()) {
+        case Level::avx2: return flip_case_at<Level::avx2>;
+        case Level::sse2: return flip_case_at<Level::sse2>;
+        default: return flip_case_at<Level::scalar>;
+        }
+    }()};
+    return fn;
+}
+
+compare_fn best_compare(void)
+{
+    static const compare_fn fn{[] {
+        switch (best_level()) {
+        case Level::avx2: return compare_at<Level::avx2>;
+        case Level::sse2: return compare_at<Level::sse2>;
+        default: return compare_at<Level::scalar>;
+        }
+    }()};
+    return fn;
+}
+} // namespace
+
+/**
+ * @brief highest kernel level this CPU can run, detected on first use
+ */
+Level best_level(void)
+{
+    static const Level level{detect_level()};
+    return level;
+}
+
+const char* level_name(Level level)
+{
+    switch (level) {
+    case Level::avx2: return "avx2";
+    case Level::sse2: return "sse2";
+    default: return "scalar";
+    }
+}
+
+void flip_case(char* s, std::size_t n, char first)
+{
+    best_flip_case()(s, n, first);
+}
+
+void flip_case(char* s, std::size_t n, char first, Level level)
+{
+    flip_case_with(usable(level), s, n, first);
+}
+
+int compare(const char* lhs, std::size_t lhs_n, const char* rhs, std::size_t rhs_n)
+{
+    return best_compare()(lhs, lhs_n, rhs, rhs_n);
+}
+
+int compare(const char* lhs, std::size_t lhs_n, const char* rhs, std::size_t rhs_n, Level level)
+{
+    return compare_with(usable(level), lhs, lhs_n, rhs, rhs_n);
+}
+
+} // namespace udemy1::myclass::simd
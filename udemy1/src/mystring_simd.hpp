@@ -0,0 +1,33 @@
+#ifndef MYSTRING_SIMD_HPP
+#define MYSTRING_SIMD_HPP
+
+#include <cstddef>
+
+/**
+ * @brief Vectorised kernels used by Mystring
+ *
+ * Each kernel has a scalar, an SSE2 (16 bytes per step) and an AVX2 (32 bytes per step)
+ * version. The overloads without a Level pick the best one the CPU supports, detected once
+ * at runtime. The explicit Level overloads exist for benchmarking and testing, asking for a
+ * level the CPU does not have falls back to the best supported one.
+ */
+namespace udemy1::myclass::simd
+{
+
+enum class Level { scalar, sse2, avx2 };
+
+Level best_level(void);             // highest level supported by this CPU
+const char* level_name(Level level); // printable name, ex.) "avx2"
+
+// toggle the ASCII case (xor 0x20) of every char in the range [first, first + 26)
+// first = 'A' lowercases the string, first = 'a' uppercases it
+void flip_case(char* s, std::size_t n, char first);
+void flip_case(char* s, std::size_t n, char first, Level level);
+
+// three way compare of two char ranges, same ordering as std::strcmp
+int compare(const char* lhs, std::size_t lhs_n, const char* rhs, std::size_t rhs_n);
+int compare(const char* lhs, std::size_t lhs_n, const char* rhs, std::size_t rhs_n, Level level);
+
+} // namespace udemy1::myclass::simd
+
+#endif // MYSTRING_SIMD_HPP
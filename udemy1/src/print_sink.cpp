@@ -0,0 +1,99 @@
+#include "print_sink.hpp"
+
+#include <charconv>
+#include <cstring>
+
+namespace udemy1
+{
+
+namespace
+{
+// the longest a Fixed can be: sign, 309 digits of DBL_MAX, the point and up to 100 decimals
+constexpr std::size_t longest_fixed{1 + 309 + 1 + 100};
+constexpr std::size_t longest_int{12};
+} // namespace
+
+std::ostream& operator<<(std::ostream& os, Fixed v)
+{
+    os.precision(v.decimals);
+    return os << std::fixed << v.value;
+}
+
+Print_sink::Print_sink(std::ostream& os)
+    : os{os}
+    , used{0}
+    , decimals{-1}
+{
+}
+
+Print_sink::~Print_sink()
+{
+    flush();
+}
+
+void Print_sink::drain(void)
+{
+    if (used) {
+        os.write(buffer, static_cast<std::streamsize>(used));
+        used = 0;
+    }
+}
+
+void Print_sink::flush(void)
+{
+    drain();
+    if (decimals >= 0) {
+        os.precision(decimals);
+        os << std::fixed;
+        decimals = -1;
+    }
+    os.flush();
+}
+
+Print_sink& Print_sink::operator<<(std::string_view s)
+{
+    if (capacity - used < s.size()) {
+        drain();
+        if (s.size() > capacity) {
+            os.write(s.data(), static_cast<std::streamsize>(s.size()));
+            return *this;
+        }
+    }
+    std::memcpy(buffer + used, s.data(), s.size());
+    used += s.size();
+    return *this;
+}
+
+Print_sink& Print_sink::operator<<(char c)
+{
+    if (used == capacity)
+        drain();
+    buffer[used++] = c;
+    return *this;
+}
+
+Print_sink& Print_sink::operator<<(int v)
+{
+    if (capacity - used < longest_int)
+        drain();
+    used = static_cast<std::size_t>(std::to_chars(buffer + used, buffer + capacity, v).ptr - buffer);
+    return *this;
+}
+
+/**
+ * @brief std::to_chars rounds the exact binary value to the nearest, as printf("%.*f") does,
+ *        and writes inf and nan the same way
+ */
+Print_sink& Print_sink::operator<<(Fixed v)
+{
+    decimals = v.decimals;
+    const int digits{v.decimals < 0 ? 6 : (v.decimals > 100 ? 100 : v.decimals)};
+    if (capacity - used < longest_fixed)
+        drain();
+    const std::to_chars_result r{
+        std::to_chars(buffer + used, buffer + capacity, v.value, std::chars_format::fixed, digits)};
+    used = static_cast<std::size_t>(r.ptr - buffer);
+    return *this;
+}
+
+} // namespace udemy1
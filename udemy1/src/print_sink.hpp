@@ -0,0 +1,61 @@
+#ifndef PRINT_SINK_HPP
+#define PRINT_SINK_HPP
+
+#include <cstddef>
+#include <iostream>
+#include <string_view>
+
+namespace udemy1
+{
+
+// a double to print with a fixed number of decimals, like os << std::fixed << std::setprecision(decimals)
+struct Fixed {
+    double value;
+    int decimals;
+};
+
+// os << std::fixed << std::setprecision(v.decimals) << v.value, the stream is left fixed
+std::ostream& operator<<(std::ostream& os, Fixed v);
+
+/**
+ * @class Print_sink
+ * @file print_sink.hpp
+ * @brief Buffered text output for the print(Print_sink&) of the account classes
+ *        Text and numbers are copied into a 64 KiB buffer, the numbers formatted with
+ *        std::to_chars, so no locale, no stream flags and no allocation is involved.
+ *        The buffer goes to the stream with one write when it fills up, the stream is only
+ *        flushed by flush() and by the destructor.
+ *        The bytes are the same that the stream would have written with the default flags,
+ *        Fixed the same as std::fixed with its precision. flush() leaves the stream fixed with
+ *        the precision of the last Fixed, as writing them to it would have.
+ */
+class Print_sink
+{
+  public:
+    static constexpr std::size_t capacity{std::size_t{1} << 16};
+
+  private:
+    std::ostream& os;
+    std::size_t used;
+    int decimals; // of the last Fixed since the last flush(), -1 for none
+    char buffer[capacity];
+
+    void drain(void); // write the buffer to the stream without flushing it
+
+  public:
+    explicit Print_sink(std::ostream& os);
+    ~Print_sink(); // flush()
+    Print_sink(const Print_sink&) = delete;
+    Print_sink& operator=(const Print_sink&) = delete;
+
+    Print_sink& operator<<(std::string_view s);
+    Print_sink& operator<<(char c);
+    Print_sink& operator<<(int v);
+    Print_sink& operator<<(Fixed v);
+
+    void flush(void); // write what is buffered and flush the stream
+};
+
+} // namespace udemy1
+
+#endif // PRINT_SINK_HPP
@@ -0,0 +1,451 @@
+#include "s15c_journal.hpp"
+
+#include <array>
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <fcntl.h>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace udemy1::s15c
+{
+
+namespace
+{
+constexpr char snapshot_magic[8]{'L', 'E', 'D', 'G', 'E', 'R', '\0', '\1'};
+constexpr std::size_t none_chunk{64 * 1024}; // bytes buffered before a write with Durability::none
+
+struct Snapshot_header {
+    char magic[8];          // "LEDGER" 0 and the format version
+    std::uint32_t checksum; // CRC-32C of everything after it, the rest of the header and the accounts
+    std::uint32_t reserved;
+    std::uint64_t next_sequence; // the first journal record not in the snapshot
+    std::uint64_t count;         // number of accounts
+};
+
+struct Snapshot_account {
+    Kind kind;
+    std::uint8_t reserved[3];
+    std::uint32_t withdrawals;
+    std::int64_t rate;
+    std::int64_t balance;
+};
+
+constexpr std::array<std::uint32_t, 256> crc_table{[] {
+    std::array<std::uint32_t, 256> table{};
+    for (std::uint32_t i{0}; i < 256; ++i) {
+        std::uint32_t c{i};
+        for (int k{0}; k < 8; ++k)
+            c = (c & 1) ? (c >> 1) ^ 0x82F63B78u : c >> 1; // Castagnoli polynomial, reflected
+        table[i] = c;
+    }
+    return table;
+}()};
+
+std::uint32_t crc32c(const void* data, std::size_t n, std::uint32_t crc = 0)
+{
+    const unsigned char* p{static_cast<const unsigned char*>(data)};
+    crc = ~crc;
+    for (std::size_t i{0}; i < n; ++i)
+        crc = crc_table[(crc ^ p[i]) & 0xFF] ^ (crc >> 8);
+    return ~crc;
+}
+
+template <typename T>
+std::uint32_t checksum_of(const T& record)
+{
+    return crc32c(reinterpret_cast<const char*>(&record) + sizeof(std::uint32_t), sizeof(T) - sizeof(std::uint32_t));
+}
+
+bool write_all(int fd, const void* data, std::size_t n)
+{
+    const char* p{static_cast<const char*>(data)};
+    while (n > 0) {
+        const ssize_t done{::write(fd, p, n)};
+        if (done < 0 && errno == EINTR)
+            continue;
+        if (done <= 0)
+            return false;
+        p += done;
+        n -= static_cast<std::size_t>(done);
+    }
+    return true;
+}
+
+// make a rename in this directory survive a crash
+bool sync_directory(const std::string& file_name)
+{
+    const std::filesystem::path dir{std::filesystem::path{file_name}.parent_path()};
+    const int fd{::open(dir.empty() ? "." : dir.c_str(), O_RDONLY | O_DIRECTORY)};
+    if (fd < 0)
+        return false;
+    const bool ok{::fsync(fd) == 0};
+    ::close(fd);
+    return ok;
+}
+} // namespace
+
+Journaled_ledger::Journaled_ledger(const std::string& path, Durability durability, std::size_t group,
+                                   std::size_t snapshot_every)
+    : path{path}
+    , durability{durability}
+    , group{group == 0 ? 1 : group}
+    , snapshot_every{snapshot_every}
+    , fd{-1}
+    , next_sequence{0}
+    , written_sequence{0}
+    , durable_sequence{0}
+    , applied_sequence{0}
+    , account_count{0}
+    , flushing{false}
+    , failed{false}
+    , since_snapshot{0}
+    , sync_count{0}
+    , replay_count{0}
+{
+    if (!recover() && fd >= 0) {
+        ::close(fd);
+        fd = -1;
+    }
+}
+
+Journaled_ledger::~Journaled_ledger()
+{
+    if (fd < 0)
+        return;
+    std::unique_lock<std::mutex> lock{mutex};
+    flush(lock, next_sequence, durability != Durability::none);
+    ::close(fd);
+}
+
+bool Journaled_ledger::is_open(void) const
+{
+    return fd >= 0 && !failed;
+}
+
+/**
+ * @brief load the snapshot, then replay the journal records that follow it
+ *
+ * The journal is read up to its first record that is short, fails its checksum or
+ * is out of sequence, and cut there, the next record is appended in its place.
+ */
+bool Journaled_ledger::recover(void)
+{
+    const std::string snapshot_name{path + ".snapshot"};
+    std::ifstream snap{snapshot_name, std::ios::binary};
+    if (snap) {
+        Snapshot_header header{};
+        std::vector<Snapshot_account> saved;
+        bool valid{static_cast<bool>(snap.read(reinterpret_cast<char*>(&header), sizeof header)) &&
+                   std::memcmp(header.magic, snapshot_magic, sizeof snapshot_magic) == 0 && header.count < UINT32_MAX};
+        if (valid) {
+            saved.resize(header.count);
+            valid = static_cast<bool>(snap.read(reinterpret_cast<char*>(saved.data()),
+                                                static_cast<std::streamsize>(saved.size() * sizeof(Snapshot_account))));
+        }
+        if (valid) {
+            std::uint32_t crc{crc32c(reinterpret_cast<const char*>(&header) + offsetof(Snapshot_header, reserved),
+                                     sizeof header - offsetof(Snapshot_header, reserved))};
+            crc = crc32c(saved.data(), saved.size() * sizeof(Snapshot_account), crc);
+            valid = crc == header.checksum;
+        }
+        if (!valid) {
+            std::cerr << "Not a ledger snapshot: " << snapshot_name << std::endl;
+            return false;
+        }
+        for (const Snapshot_account& acc : saved)
+            accounts.open(acc.kind, Money::from_units(acc.balance), Rate::from_units(acc.rate),
+                          static_cast<int>(acc.withdrawals));
+        next_sequence = header.next_sequence;
+    }
+
+    const std::string journal_name{path + ".journal"};
+    fd = ::open(journal_name.c_str(), O_RDWR | O_CREAT | O_APPEND, 0644);
+    if (fd < 0) {
+        std::cerr << "File open error: " << journal_name << std::endl;
+        return false;
+    }
+
+    std::vector<Record> chunk(4096);
+    off_t good_end{0};
+    bool torn{false};
+    while (!torn) {
+        const ssize_t got{::pread(fd, chunk.data(), chunk.size() * sizeof(Record), good_end)};
+        if (got < 0 && errno == EINTR)
+            continue;
+        if (got <= 0)
+            break;
+        const std::size_t records{static_cast<std::size_t>(got) / sizeof(Record)};
+        torn = records == 0; // a piece of a record at the end
+        for (std::size_t i{0}; i < records && !torn; ++i) {
+            const Record& r{chunk[i]};
+            if (r.checksum != checksum_of(r) || r.sequence > next_sequence) {
+                torn = true;
+            } else {
+                if (r.sequence == next_sequence) { // older ones are in the snapshot already
+                    if (!apply(r)) {
+                        torn = true;
+                        break;
+                    }
+                    ++next_sequence;
+                    ++replay_count;
+                }
+                good_end += static_cast<off_t>(sizeof(Record));
+            }
+        }
+    }
+
+    struct stat st {};
+    if (::fstat(fd, &st) != 0 || (st.st_size != good_end && ::ftruncate(fd, good_end) != 0)) {
+        std::cerr << "Journal recovery error: " << journal_name << std::endl;
+        return false;
+    }
+    written_sequence = durable_sequence = applied_sequence = next_sequence;
+    account_count = accounts.size();
+    return true;
+}
+
+/**
+ * @brief apply one journaled operation to the accounts, false for a record that can not apply
+ */
+bool Journaled_ledger::apply(const Record& r)
+{
+    if (r.type != Type::open && r.type != Type::new_period && r.account >= accounts.size())
+        return false;
+    switch (r.type) {
+    case Type::open:
+        accounts.open(r.kind, Money::from_units(r.amount), Rate::from_units(r.rate), static_cast<int>(r.withdrawals));
+        return true;
+    case Type::deposit: accounts.deposit(r.account, Money::from_units(r.amount)); return true;
+    case Type::withdraw: accounts.withdraw(r.account, Money::from_units(r.amount)); return true;
+    case Type::new_period: accounts.new_period(); return true;
+    }
+    return false;
+}
+
+/**
+ * @brief journal an operation, apply it, and wait for as much durability as asked for
+ *
+ * done is what the account said, false for an account that does not exist.
+ * per_op applies the operation once its record is synced, after every record before it,
+ * a journal that fails first returns false with the operation not applied. none and
+ * batched apply it at once, ahead of its write: false then says the write it set off
+ * failed, the operations since the last sync are in the accounts and may not be on the disk.
+ */
+bool Journaled_ledger::append(Record& r, bool& done)
+{
+    std::unique_lock<std::mutex> lock{mutex};
+    done = false;
+    if (!is_open())
+        return false;
+    if (r.type == Type::open)
+        r.account = account_count++;
+    else if (r.type != Type::new_period && r.account >= account_count)
+        return true; // no such account, refused without a record
+
+    r.sequence = next_sequence++;
+    r.checksum = checksum_of(r);
+    pending.push_back(r);
+    ++since_snapshot;
+
+    auto apply_in_order = [&] {
+        switch (r.type) {
+        case Type::deposit: done = accounts.deposit(r.account, Money::from_units(r.amount)); break;
+        case Type::withdraw: done = accounts.withdraw(r.account, Money::from_units(r.amount)); break;
+        default: done = apply(r); break;
+        }
+        ++applied_sequence;
+    };
+
+    bool ok{true};
+    switch (durability) {
+    case Durability::none:
+        apply_in_order();
+        if (pending.size() * sizeof(Record) >= none_chunk)
+            ok = flush(lock, next_sequence, false);
+        break;
+    case Durability::batched:
+        apply_in_order();
+        if (pending.size() >= group)
+            ok = flush(lock, next_sequence, true);
+        break;
+    case Durability::per_op:
+        if (!flush(lock, r.sequence + 1, true))
+            return false;
+        // synced with others, the records before it are applied first
+        synced.wait(lock, [&] { return applied_sequence == r.sequence; });
+        apply_in_order();
+        synced.notify_all();
+        break;
+    }
+    if (ok && snapshot_every != 0 && since_snapshot >= snapshot_every)
+        ok = write_snapshot(lock);
+    return ok;
+}
+
+/**
+ * @brief group commit, make sure the records before upto are written, and synced if asked
+ *
+ * One thread at a time writes out everything pending and syncs it, without the lock,
+ * so the other threads go on appending. A thread that finds a flush running waits for
+ * it, and if its record came too late for it, the next thread through flushes the
+ * records that piled up meanwhile with a single sync.
+ */
+bool Journaled_ledger::flush(std::unique_lock<std::mutex>& lock, std::uint64_t upto, bool sync)
+{
+    while (!failed && (sync ? durable_sequence : written_sequence) < upto) {
+        if (flushing) {
+            synced.wait(lock);
+            continue;
+        }
+        flushing = true;
+        std::vector<Record> out;
+        out.swap(pending);
+        const std::uint64_t end{next_sequence};
+
+        lock.unlock();
+        bool ok{write_all(fd, out.data(), out.size() * sizeof(Record))};
+        const bool synced_now{ok && sync};
+        if (synced_now)
+            ok = ::fdatasync(fd) == 0;
+        lock.lock();
+
+        flushing = false;
+        if (ok) {
+            written_sequence = end;
+            if (synced_now) {
+                durable_sequence = end;
+                ++sync_count;
+            }
+        } else {
+            failed = true;
+            std::cerr << "Journal write error: " << path << ".journal: " << std::strerror(errno) << std::endl;
+        }
+        synced.notify_all();
+    }
+    return (sync ? durable_sequence : written_sequence) >= upto; // a later failure does not undo it
+}
+
+/**
+ * @brief save every account to <path>.snapshot and empty the journal
+ *
+ * The snapshot is written to a temporary file, synced and renamed over the old one.
+ * If the journal is not emptied before a crash, its records are older than the
+ * snapshot and skipped on the next open.
+ */
+bool Journaled_ledger::write_snapshot(std::unique_lock<std::mutex>& lock)
+{
+    // every record synced and applied, per_op threads apply theirs once synced
+    while (!failed && (flushing || !pending.empty() || durable_sequence < next_sequence ||
+                       applied_sequence < next_sequence)) {
+        if (flushing || durable_sequence == next_sequence)
+            synced.wait(lock);
+        else
+            flush(lock, next_sequence, true);
+    }
+    if (failed)
+        return false;
+
+    Snapshot_header header{};
+    std::memcpy(header.magic, snapshot_magic, sizeof snapshot_magic);
+    header.next_sequence = next_sequence;
+    header.count = accounts.size();
+    std::vector<Snapshot_account> saved(accounts.size());
+    for (std::uint32_t i{0}; i < accounts.size(); ++i)
+        saved[i] = Snapshot_account{accounts.kind_of(i), {0, 0, 0}, static_cast<std::uint32_t>(accounts.withdrawals(i)),
+                                    accounts.rate_of(i).units(), accounts.balance(i).units()};
+    header.checksum = crc32c(reinterpret_cast<const char*>(&header) + offsetof(Snapshot_header, reserved),
+                             sizeof header - offsetof(Snapshot_header, reserved));
+    header.checksum = crc32c(saved.data(), saved.size() * sizeof(Snapshot_account), header.checksum);
+
+    const std::string snapshot_name{path + ".snapshot"};
+    const std::string temp_name{snapshot_name + ".tmp"};
+    const int snap{::open(temp_name.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644)};
+    bool ok{snap >= 0 && write_all(snap, &header, sizeof header) &&
+            write_all(snap, saved.data(), saved.size() * sizeof(Snapshot_account)) && ::fsync(snap) == 0};
+    if (snap >= 0)
+        ok = (::close(snap) == 0) && ok;
+    ok = ok && ::rename(temp_name.c_str(), snapshot_name.c_str()) == 0 && sync_directory(snapshot_name) &&
+         ::ftruncate(fd, 0) == 0;
+    if (!ok) {
+        failed = true;
+        std::cerr << "Snapshot write error: " << snapshot_name << ": " << std::strerror(errno) << std::endl;
+        return false;
+    }
+    since_snapshot = 0;
+    return true;
+}
+
+bool Journaled_ledger::open(Kind k, Money balance, Rate r, std::uint32_t& account)
+{
+    Record rec{};
+    rec.type = Type::open;
+    rec.kind = k;
+    rec.amount = balance.units();
+    rec.rate = r.units();
+    bool done{false};
+    const bool ok{append(rec, done) && done};
+    account = rec.account;
+    return ok;
+}
+
+bool Journaled_ledger::deposit(std::uint32_t account, Money amt)
+{
+    Record rec{};
+    rec.type = Type::deposit;
+    rec.account = account;
+    rec.amount = amt.units();
+    bool done{false};
+    return append(rec, done) && done;
+}
+
+bool Journaled_ledger::withdraw(std::uint32_t account, Money amt)
+{
+    Record rec{};
+    rec.type = Type::withdraw;
+    rec.account = account;
+    rec.amount = amt.units();
+    bool done{false};
+    return append(rec, done) && done;
+}
+
+bool Journaled_ledger::new_period(void)
+{
+    Record rec{};
+    rec.type = Type::new_period;
+    bool done{false};
+    return append(rec, done) && done;
+}
+
+bool Journaled_ledger::commit(void)
+{
+    std::unique_lock<std::mutex> lock{mutex};
+    return is_open() && flush(lock, next_sequence, true);
+}
+
+bool Journaled_ledger::snapshot(void)
+{
+    std::unique_lock<std::mutex> lock{mutex};
+    return is_open() && write_snapshot(lock);
+}
+
+const Ledger& Journaled_ledger::ledger(void) const
+{
+    return accounts;
+}
+
+std::size_t Journaled_ledger::syncs(void) const
+{
+    return sync_count;
+}
+
+std::size_t Journaled_ledger::replayed(void) const
+{
+    return replay_count;
+}
+
+} // namespace udemy1::s15c
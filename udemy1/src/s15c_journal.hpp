@@ -0,0 +1,108 @@
+#ifndef S15C_JOURNAL_HPP
+#define S15C_JOURNAL_HPP
+
+#include "s15c_ledger.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace udemy1::s15c
+{
+
+// when a journaled operation is on the disk
+enum class Durability : std::uint8_t {
+    none,    // applied at once, written to the file in 64 KiB chunks, never synced, lost with the machine
+    batched, // applied at once, synced once every group operations and on commit(), the last group can be lost
+    per_op   // applied once synced, in journal order, the threads waiting share one fdatasync
+};
+
+/**
+ * @class Journaled_ledger
+ * @file s15c_journal.hpp
+ * @brief A Ledger that survives a restart, each operation is appended to a write-ahead
+ *        journal before it is applied
+ *        <path>.journal   one Record per operation, appended, each with a CRC-32C
+ *        <path>.snapshot  every account as of a journal sequence number, replaced as a whole
+ *                         through a rename, after which the journal starts again empty
+ *        Opening replays the snapshot and then the journal records after it. A record that
+ *        is cut short or fails its checksum ends the journal, it and anything after it were
+ *        never committed and are cut off.
+ *        The operations are thread safe, one at a time in journal order, read ledger() while
+ *        none is running.
+ */
+class Journaled_ledger
+{
+  private:
+    enum class Type : std::uint8_t { open, deposit, withdraw, new_period };
+
+    struct Record {
+        std::uint32_t checksum; // CRC-32C of the rest of the record
+        Type type;
+        Kind kind; // open only
+        std::uint16_t reserved;
+        std::uint32_t account;
+        std::uint32_t withdrawals; // open only
+        std::uint64_t sequence;    // one more than the record before
+        std::int64_t amount;       // minor units, the opening balance for open
+        std::int64_t rate;         // open only
+    };
+
+    Ledger accounts;
+    std::string path;
+    Durability durability;
+    std::size_t group;          // batched: operations per sync
+    std::size_t snapshot_every; // operations between automatic snapshots, 0 for none
+    int fd;                     // the journal, -1 when it could not be opened
+
+    std::mutex mutex; // one writer at a time, the journal order is the order applied
+    std::condition_variable synced;
+    std::vector<Record> pending; // appended, not yet written
+    std::uint64_t next_sequence;
+    std::uint64_t written_sequence; // records before it are written to the file
+    std::uint64_t durable_sequence; // records before it are synced
+    std::uint64_t applied_sequence; // records before it are applied to the accounts
+    std::uint32_t account_count;    // accounts opened in the journal, applied or not
+    bool flushing;                  // a thread is writing and syncing, outside the lock
+    std::atomic<bool> failed;       // a write or sync failed, nothing more is accepted
+    std::size_t since_snapshot;
+    std::size_t sync_count;
+    std::size_t replay_count;
+
+    bool recover(void);
+    bool append(Record& r, bool& done);
+    bool flush(std::unique_lock<std::mutex>& lock, std::uint64_t upto, bool sync);
+    bool write_snapshot(std::unique_lock<std::mutex>& lock);
+    bool apply(const Record& r);
+
+  public:
+    // open or create <path>.journal and <path>.snapshot and recover the accounts from them
+    Journaled_ledger(const std::string& path, Durability durability, std::size_t group = 64,
+                     std::size_t snapshot_every = 0);
+    ~Journaled_ledger(); // commits what is pending
+    Journaled_ledger(const Journaled_ledger&) = delete;
+    Journaled_ledger& operator=(const Journaled_ledger&) = delete;
+
+    bool is_open(void) const; // false when the files could not be read or a write failed
+
+    // the Ledger operations, thread safe, false when the account refuses or the journal fails
+    bool open(Kind k, Money balance, Rate r, std::uint32_t& account);
+    bool deposit(std::uint32_t account, Money amt);
+    bool withdraw(std::uint32_t account, Money amt);
+    bool new_period(void);
+
+    bool commit(void);   // sync everything journaled so far
+    bool snapshot(void); // save every account and empty the journal
+
+    const Ledger& ledger(void) const;
+    std::size_t syncs(void) const;    // fdatasync calls so far
+    std::size_t replayed(void) const; // journal records applied when opening
+};
+
+} // namespace udemy1::s15c
+
+#endif // S15C_JOURNAL_HPP
@@ -0,0 +1,141 @@
+#include "s15c_ledger.hpp"
+
+#include <algorithm>
+#include <omp.h>
+
+namespace udemy1::s15c
+{
+
+Ledger::Ledger()
+    : capacity{0}
+{
+}
+
+std::uint32_t Ledger::open(Kind k, Money balance, Rate r, int withdrawals)
+{
+    if (kind.size() == capacity) {
+        const std::size_t grown{std::max<std::size_t>(16, 2 * capacity)};
+        std::unique_ptr<std::atomic<std::int64_t>[]> moved{new std::atomic<std::int64_t>[grown]};
+        for (std::size_t i{0}; i < kind.size(); ++i)
+            moved[i].store(state[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+        state = std::move(moved);
+        capacity = grown;
+    }
+    state[kind.size()].store((balance.units() << count_bits) | (withdrawals & count_mask), std::memory_order_relaxed);
+    kind.push_back(k);
+    rate.push_back(r);
+    return static_cast<std::uint32_t>(kind.size() - 1);
+}
+
+std::size_t Ledger::size(void) const
+{
+    return kind.size();
+}
+
+Kind Ledger::kind_of(std::uint32_t account) const
+{
+    return kind[account];
+}
+
+Rate Ledger::rate_of(std::uint32_t account) const
+{
+    return rate[account];
+}
+
+/**
+ * @brief Account::deposit, after the savings interest and the trust bonus are added
+ */
+bool Ledger::deposit(std::uint32_t account, Money amt)
+{
+    switch (kind[account]) {
+    case Kind::trust:
+        if (amt >= bonus_low_limit)
+            amt += bonus_amt;
+        [[fallthrough]];
+    case Kind::savings: amt += interest(amt, rate[account]); break;
+    default: break;
+    }
+    if (amt < Money{})
+        return false;
+    state[account].fetch_add(amt.units() * (count_mask + 1), std::memory_order_acq_rel);
+    return true;
+}
+
+/**
+ * @brief Account::withdraw, after the checking fee is added and the trust limits are checked
+ *
+ * The checks and the update work on one snapshot of the state word, the compare and
+ * swap only succeeds if no other thread changed the account in between, otherwise
+ * it is tried again with the new state.
+ */
+bool Ledger::withdraw(std::uint32_t account, Money amt)
+{
+    const Kind k{kind[account]};
+    if (k == Kind::checking)
+        amt += per_withdraw_fee;
+
+    std::atomic<std::int64_t>& word{state[account]};
+    std::int64_t old{word.load(std::memory_order_acquire)};
+    for (;;) {
+        const std::int64_t balance{old >> count_bits};
+        std::int64_t count{old & count_mask};
+        bool done{balance - amt.units() >= 0};
+
+        if (k == Kind::trust) {
+            // amt > balance * 20%, same as the class but exact
+            if (count >= max_withdraw_limit || amt.units() * 5 > balance)
+                return false;
+            ++count; // counted even when the balance then refuses it, like Trust_Account
+        } else if (!done) {
+            return false;
+        }
+
+        const std::int64_t updated{((done ? balance - amt.units() : balance) << count_bits) | count};
+        if (word.compare_exchange_weak(old, updated, std::memory_order_acq_rel, std::memory_order_acquire))
+            return done;
+    }
+}
+
+Money Ledger::balance(std::uint32_t account) const
+{
+    return Money::from_units(state[account].load(std::memory_order_acquire) >> count_bits);
+}
+
+int Ledger::withdrawals(std::uint32_t account) const
+{
+    return static_cast<int>(state[account].load(std::memory_order_acquire) & count_mask);
+}
+
+void Ledger::new_period(void)
+{
+    for (std::size_t i{0}; i < kind.size(); ++i)
+        if (kind[i] == Kind::trust)
+            state[i].fetch_and(~count_mask, std::memory_order_acq_rel);
+}
+
+/**
+ * @brief post a batch from several threads, each posting applies once, in no set order
+ */
+std::size_t post(Ledger& ledger, std::span<const Posting> postings, std::vector<Post_result>& results, int threads)
+{
+    if (threads <= 0)
+        threads = omp_get_max_threads();
+
+    results.resize(postings.size());
+    std::size_t posted{0};
+#pragma omp parallel for num_threads(threads) schedule(static) reduction(+ : posted)
+    for (std::size_t i = 0; i < postings.size(); ++i) {
+        const Posting& p{postings[i]};
+        Post_result result{Post_result::no_account};
+        if (p.account < ledger.size()) {
+            const Money amt{Money::from_double(p.amount)};
+            const bool done{(p.op == Op::deposit) ? ledger.deposit(p.account, amt) : ledger.withdraw(p.account, amt)};
+            result = done ? Post_result::ok : Post_result::failed;
+            posted += done;
+        }
+        results[i] = result;
+    }
+    return posted;
+}
+
+} // namespace udemy1::s15c
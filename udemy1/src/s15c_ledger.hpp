@@ -0,0 +1,77 @@
+#ifndef S15C_LEDGER_HPP
+#define S15C_LEDGER_HPP
+
+#include "money.hpp"
+#include "s15c_posting.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace udemy1::s15c
+{
+
+// which of the s15c account classes an account of a Ledger follows
+enum class Kind : std::uint8_t { account, checking, savings, trust };
+
+/**
+ * @class Ledger
+ * @file s15c_ledger.hpp
+ * @brief Accounts that many threads can deposit to and withdraw from at the same time
+ *        Every account follows the rules of its s15c class (checking fee, savings interest,
+ *        trust bonus, 20% limit and 3 withdrawals per period) with Money amounts.
+ *
+ *        The balance and the trust withdrawal count of an account share one atomic word,
+ *        balance * 4 + withdrawals, so a withdrawal checks and updates both with a single
+ *        compare and swap: no balance goes below zero and no 4th trust withdrawal gets in,
+ *        however many threads race for the account. Deposits can not fail on the balance,
+ *        they are one atomic add.
+ *
+ *        Opening accounts is not thread safe, everything else is.
+ *        Balances must stay within +-2^61 minor units.
+ */
+class Ledger
+{
+  private:
+    static constexpr Money bonus_low_limit{Money::from_units(5000'00)};
+    static constexpr Money bonus_amt{Money::from_units(50'00)};
+    static constexpr Money per_withdraw_fee{Money::from_units(1'50)};
+    static constexpr int max_withdraw_limit = 3;
+    static constexpr std::int64_t count_bits{2}; // low bits of a state word, the withdrawals this period
+    static constexpr std::int64_t count_mask{(1 << count_bits) - 1};
+
+    std::vector<Kind> kind;
+    std::vector<Rate> rate;
+    std::unique_ptr<std::atomic<std::int64_t>[]> state; // balance * 4 + withdrawals, per account
+    std::size_t capacity;
+
+  public:
+    Ledger();
+
+    // add an account, returns its number, not thread safe
+    std::uint32_t open(Kind k, Money balance, Rate r = Rate{}, int withdrawals = 0);
+    std::size_t size(void) const;
+    Kind kind_of(std::uint32_t account) const;
+    Rate rate_of(std::uint32_t account) const;
+
+    // thread safe, false when the rules of the account refuse the amount
+    bool deposit(std::uint32_t account, Money amt);
+    bool withdraw(std::uint32_t account, Money amt);
+
+    Money balance(std::uint32_t account) const;
+    int withdrawals(std::uint32_t account) const; // trust withdrawals this period
+    void new_period(void);                        // the trust accounts may withdraw 3 times again
+};
+
+// Posts a batch from several threads at once (0 uses the OpenMP default), the postings are
+// spread over the threads so they do not apply in order, but each one applies exactly once.
+// results is resized to one Post_result per posting, returns the number that succeeded.
+std::size_t post(Ledger& ledger, std::span<const Posting> postings, std::vector<Post_result>& results,
+                 int threads = 0);
+
+} // namespace udemy1::s15c
+
+#endif // S15C_LEDGER_HPP
@@ -0,0 +1,81 @@
+#include "s15c_posting.hpp"
+
+namespace udemy1::s15c
+{
+
+namespace
+{
+/**
+ * @brief Log one posting, in the words of the s15c_account_util helpers
+ */
+template <typename Acc>
+void log_posting(std::ostream& log, const std::vector<Acc>& account, const Posting& p, Post_result result)
+{
+    const bool deposit{p.op == Op::deposit};
+    switch (result) {
+    case Post_result::ok:
+        log << (deposit ? "Deposited " : "Withdrew ") << p.amount << (deposit ? " to " : " from ")
+            << account[p.account] << '\n';
+        break;
+    case Post_result::failed:
+        log << (deposit ? "Failed Deposit of " : "Failed Withdrawal of ") << p.amount
+            << (deposit ? " to " : " from ") << account[p.account] << '\n';
+        break;
+    case Post_result::no_account:
+        log << (deposit ? "Failed Deposit of " : "Failed Withdrawal of ") << p.amount
+            << (deposit ? " to " : " from ") << "account " << p.account << ": no such account" << '\n';
+        break;
+    }
+}
+
+/**
+ * @brief The engine, one instance per account type so every call is a direct call
+ */
+template <typename Acc>
+std::size_t post_all(std::vector<Acc>& account, std::span<const Posting> postings, std::vector<Post_result>& results,
+                     std::ostream* log)
+{
+    results.resize(postings.size());
+    std::size_t posted{0};
+    for (std::size_t i{0}; i < postings.size(); ++i) {
+        const Posting& p{postings[i]};
+        Post_result result{Post_result::no_account};
+        if (p.account < account.size()) {
+            Acc& acc{account[p.account]};
+            const bool done{(p.op == Op::deposit) ? acc.deposit(p.amount) : acc.withdraw(p.amount)};
+            result = done ? Post_result::ok : Post_result::failed;
+            posted += done;
+        }
+        results[i] = result;
+        if (log != nullptr)
+            log_posting(*log, account, p, result);
+    }
+    return posted;
+}
+} // namespace
+
+std::size_t post(std::vector<Account>& account, std::span<const Posting> postings, std::vector<Post_result>& results,
+                 std::ostream* log)
+{
+    return post_all(account, postings, results, log);
+}
+
+std::size_t post(std::vector<Savings_Account>& account, std::span<const Posting> postings,
+                 std::vector<Post_result>& results, std::ostream* log)
+{
+    return post_all(account, postings, results, log);
+}
+
+std::size_t post(std::vector<Checking_Account>& account, std::span<const Posting> postings,
+                 std::vector<Post_result>& results, std::ostream* log)
+{
+    return post_all(account, postings, results, log);
+}
+
+std::size_t post(std::vector<Trust_Account>& account, std::span<const Posting> postings,
+                 std::vector<Post_result>& results, std::ostream* log)
+{
+    return post_all(account, postings, results, log);
+}
+
+} // namespace udemy1::s15c
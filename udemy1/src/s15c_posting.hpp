@@ -0,0 +1,55 @@
+#ifndef S15C_POSTING_HPP
+#define S15C_POSTING_HPP
+
+#include "s15c_account.hpp"
+#include "s15c_checking_account.hpp"
+#include "s15c_savings_account.hpp"
+#include "s15c_trust_account.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <span>
+#include <vector>
+
+namespace udemy1::s15c
+{
+
+enum class Op : std::uint8_t { deposit, withdraw };
+
+// outcome of one posting
+enum class Post_result : std::uint8_t {
+    ok,        // the account accepted the deposit or withdrawal
+    failed,    // the account refused it, ex.) not enough balance, 4th trust withdrawal
+    no_account // the account index is past the end of the vector
+};
+
+/**
+ * @struct Posting
+ * @file s15c_posting.hpp
+ * @brief One transaction of a batch: amount deposited to, or withdrawn from, accounts[account]
+ */
+struct Posting {
+    double amount;
+    std::uint32_t account;
+    Op op;
+};
+
+// Batch posting engine
+// Applies the postings in order through each account's own deposit / withdraw, so every rule
+// (checking fee, savings interest, trust bonus and withdrawal limits) is the same as one call at a time.
+// results is resized to one Post_result per posting. When log is given, the line the helpers in
+// s15c_account_util print is written to it for each posting, nothing is printed otherwise.
+// Returns the number of postings that succeeded.
+std::size_t post(std::vector<Account>& account, std::span<const Posting> postings, std::vector<Post_result>& results,
+                 std::ostream* log = nullptr);
+std::size_t post(std::vector<Savings_Account>& account, std::span<const Posting> postings,
+                 std::vector<Post_result>& results, std::ostream* log = nullptr);
+std::size_t post(std::vector<Checking_Account>& account, std::span<const Posting> postings,
+                 std::vector<Post_result>& results, std::ostream* log = nullptr);
+std::size_t post(std::vector<Trust_Account>& account, std::span<const Posting> postings,
+                 std::vector<Post_result>& results, std::ostream* log = nullptr);
+
+} // namespace udemy1::s15c
+
+#endif // S15C_POSTING_HPP
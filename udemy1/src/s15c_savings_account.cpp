@@ -17,6 +17,11 @@ bool Savings_Account::deposit(double amt)
     return Account::deposit(amt);
 }
 
+double Savings_Account::get_int_rate() const
+{
+    return int_rate;
+}
+
 std::ostream& operator<<(std::ostream& os, const Savings_Account& acc)
 {
     os << "[Savings_Account: " << acc.name << ": " << acc.balance << ", " << acc.int_rate << "%]";
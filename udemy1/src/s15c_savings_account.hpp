@@ -33,6 +33,7 @@ class Savings_Account : public Account
     Savings_Account(std::string n = def_name, double b = def_balance, double r = def_int_rate);
     ~Savings_Account();
     bool deposit(double amt);
+    double get_int_rate() const;
     // withdraw is inherited
 };
 
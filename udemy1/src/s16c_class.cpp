@@ -9,6 +9,12 @@ std::ostream& operator<<(std::ostream& os, const I_Printable& obj)
     return os;
 }
 
+Print_sink& operator<<(Print_sink& out, const I_Printable& obj)
+{
+    obj.print(out);
+    return out;
+}
+
 //------------------------------------------------------------------------------------
 Account::Account(std::string n, double b)
     : name{n}
@@ -41,11 +47,20 @@ double Account::get_balance(void) const
     return balance;
 }
 
+template <typename Out>
+void Account::write_to(Out& out) const
+{
+    out << "[Account: " << this->name << ": " << Fixed{this->balance, 2} << "]";
+}
+
 void Account::print(std::ostream& os) const
 {
-    os.precision(2);
-    os << std::fixed;
-    os << "[Account: " << this->name << ": " << this->balance << "]";
+    write_to(os);
+}
+
+void Account::print(Print_sink& out) const
+{
+    write_to(out);
 }
 
 //------------------------------------------------------------------------------------
@@ -66,11 +81,21 @@ bool Savings::withdraw(double amt)
     return Account::withdraw(amt);
 }
 
+template <typename Out>
+void Savings::write_to(Out& out) const
+{
+    out << "[Savings_Account: " << this->name << ": " << Fixed{this->balance, 2} << ", " << Fixed{this->int_rate, 2}
+        << "%]";
+}
+
 void Savings::print(std::ostream& os) const
 {
-    os.precision(2);
-    os << std::fixed;
-    os << "[Savings_Account: " << this->name << ": " << this->balance << ", " << this->int_rate << "%]";
+    write_to(os);
+}
+
+void Savings::print(Print_sink& out) const
+{
+    write_to(out);
 }
 
 //------------------------------------------------------------------------------------
@@ -90,11 +115,20 @@ bool Checking::deposit(double amt)
     return Account::deposit(amt);
 }
 
+template <typename Out>
+void Checking::write_to(Out& out) const
+{
+    out << "[Checking: " << this->name << ": " << Fixed{this->balance, 2} << "]";
+}
+
 void Checking::print(std::ostream& os) const
 {
-    os.precision(2);
-    os << std::fixed;
-    os << "[Checking: " << this->name << ": " << this->balance << "]";
+    write_to(os);
+}
+
+void Checking::print(Print_sink& out) const
+{
+    write_to(out);
 }
 
 //------------------------------------------------------------------------------------
@@ -123,20 +157,30 @@ bool Trust::withdraw(double amt)
     }
 }
 
+template <typename Out>
+void Trust::write_to(Out& out) const
+{
+    out << "[Trust: " << this->name << ": " << Fixed{this->balance, 2} << ", " << Fixed{this->int_rate, 2}
+        << "%, withdrawals: " << this->num_withdraw << "]";
+}
+
 void Trust::print(std::ostream& os) const
 {
-    os.precision(2);
-    os << std::fixed;
-    os << "[Trust: " << this->name << ": " << this->balance << ", " << this->int_rate
-       << "%, withdrawals: " << this->num_withdraw << "]";
+    write_to(os);
+}
+
+void Trust::print(Print_sink& out) const
+{
+    write_to(out);
 }
 
 //------------------------------------------------------------------------------------
 void display(std::vector<Account*>& accounts)
 {
     std::cout << "\n=== Displaying Accounts ===============================================" << std::endl;
+    Print_sink out{std::cout};
     for (const Account* const acc : accounts)
-        std::cout << *acc << std::endl;
+        out << *acc << '\n';
 }
 
 void deposit(std::vector<Account*>& accounts, double amt)
@@ -161,4 +205,23 @@ void withdraw(std::vector<Account*>& accounts, double amt)
     }
 }
 
+void display(const Account_store& accounts)
+{
+    std::cout << "\n=== Displaying Accounts ===============================================" << std::endl;
+    Print_sink out{std::cout};
+    accounts.print(out);
+}
+
+void deposit(Account_store& accounts, double amt)
+{
+    std::cout << "\n=== Depositing to Accounts ============================================" << std::endl;
+    accounts.deposit(amt, std::cout);
+}
+
+void withdraw(Account_store& accounts, double amt)
+{
+    std::cout << "\n=== Withdrawing from Accounts =========================================" << std::endl;
+    accounts.withdraw(amt, std::cout);
+}
+
 } // namespace udemy1::s16c
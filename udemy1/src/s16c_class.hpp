@@ -1,6 +1,10 @@
 #ifndef S16C_CLASS_HPP
 #define S16C_CLASS_HPP
 
+#include "account_pool.hpp"
+#include "account_store.hpp"
+#include "print_sink.hpp"
+
 #include <iostream>
 #include <vector>
 
@@ -16,10 +20,12 @@ namespace udemy1::s16c
 class I_Printable
 {
     friend std::ostream& operator<<(std::ostream& os, const I_Printable& obj);
+    friend Print_sink& operator<<(Print_sink& out, const I_Printable& obj);
 
   public:
     ~I_Printable() = default;
     virtual void print(std::ostream& os) const = 0;
+    virtual void print(Print_sink& out) const = 0; // the same bytes, buffered
 };
 
 /**
@@ -45,7 +51,12 @@ class Account : public I_Printable
     virtual bool deposit(double amt) = 0;
     virtual bool withdraw(double amt) = 0;
     virtual void print(std::ostream& os) const override;
+    virtual void print(Print_sink& out) const override;
     double get_balance(void) const;
+
+  private:
+    template <typename Out>
+    void write_to(Out& out) const; // the one format of both prints
 };
 
 /**
@@ -71,6 +82,11 @@ class Savings : public Account
     virtual bool withdraw(double amt) override;
     virtual bool deposit(double amt) override;
     virtual void print(std::ostream& os) const override;
+    virtual void print(Print_sink& out) const override;
+
+  private:
+    template <typename Out>
+    void write_to(Out& out) const; // the one format of both prints
 };
 
 /**
@@ -93,6 +109,11 @@ class Checking : public Account
     virtual bool withdraw(double amt) override;
     virtual bool deposit(double amt) override;
     virtual void print(std::ostream& os) const override;
+    virtual void print(Print_sink& out) const override;
+
+  private:
+    template <typename Out>
+    void write_to(Out& out) const; // the one format of both prints
 };
 
 /**
@@ -124,6 +145,11 @@ class Trust : public Savings
     virtual bool deposit(double amt) override;  // $50 bonus if deposit is >= $5000
     virtual bool withdraw(double amt) override; // max 3 transaction allowed, max allowed 20% or balance
     virtual void print(std::ostream& os) const override;
+    virtual void print(Print_sink& out) const override;
+
+  private:
+    template <typename Out>
+    void write_to(Out& out) const; // the one format of both prints
 };
 
 // Util Functions
@@ -131,6 +157,17 @@ void display(std::vector<Account*>& accounts);
 void deposit(std::vector<Account*>& accounts, double amt);
 void withdraw(std::vector<Account*>& accounts, double amt);
 
+// Accounts held by value in one vector, the bulk calls need no virtual dispatch
+using Account_store = udemy1::Basic_account_store<Checking, Savings, Trust>;
+
+// Util Functions for Account_store, same output as the ones for std::vector<Account*>
+void display(const Account_store& accounts);
+void deposit(Account_store& accounts, double amt);
+void withdraw(Account_store& accounts, double amt);
+
+// Accounts made one after the other in an arena and released together, use them as Account*
+using Account_pool = udemy1::Basic_account_pool<Account>;
+
 } // namespace udemy1::s16c
 
 #endif // S16C_CLASS_HPP
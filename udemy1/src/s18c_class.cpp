@@ -13,12 +13,29 @@ const char* InsufficentFundsException::what() const noexcept
     return "Insufficient Funds Exception";
 }
 
+const char* to_string(Account_error error)
+{
+    switch (error) {
+    case Account_error::none: return "No Error";
+    case Account_error::negative_deposit: return "Negative Deposit";
+    case Account_error::insufficient_funds: return "Insufficient Funds";
+    case Account_error::withdrawal_limit: return "Withdrawal Limit";
+    }
+    return "Unknown Error";
+}
+
 std::ostream& operator<<(std::ostream& os, const I_Printable& obj)
 {
     obj.print(os);
     return os;
 }
 
+Print_sink& operator<<(Print_sink& out, const I_Printable& obj)
+{
+    obj.print(out);
+    return out;
+}
+
 Account::Account(std::string name, double balance)
     : name{name}
     , balance{balance}
@@ -27,30 +44,53 @@ Account::Account(std::string name, double balance)
         throw IllegalBalanceException();
 }
 
-bool Account::deposit(double amount)
+Result Account::try_deposit(double amount) noexcept
 {
     if (amount < 0)
-        return false;
+        return Account_error::negative_deposit;
     else {
         balance += amount;
-        return true;
+        return {};
     }
 }
 
-bool Account::withdraw(double amount)
+Result Account::try_withdraw(double amount) noexcept
 {
     if (balance - amount >= 0) {
         balance -= amount;
-        return true;
+        return {};
     } else
+        return Account_error::insufficient_funds;
+}
+
+bool Account::deposit(double amount)
+{
+    return try_deposit(amount).has_value();
+}
+
+// the overdraft is the only error that is reported with an exception, as before
+bool Account::withdraw(double amount)
+{
+    const Result result{try_withdraw(amount)};
+    if (result.error() == Account_error::insufficient_funds)
         throw InsufficentFundsException();
+    return result.has_value();
+}
+
+template <typename Out>
+void Account::write_to(Out& out) const
+{
+    out << "[Account: " << name << ": " << Fixed{balance, 2} << "]";
 }
 
 void Account::print(std::ostream& os) const
 {
-    os.precision(2);
-    os << std::fixed;
-    os << "[Account: " << name << ": " << balance << "]";
+    write_to(os);
+}
+
+void Account::print(Print_sink& out) const
+{
+    write_to(out);
 }
 
 Checking_Account::Checking_Account(std::string name, double balance)
@@ -60,22 +100,31 @@ try : Account{name, balance} {
     ;
 }
 
-bool Checking_Account::withdraw(double amount)
+Result Checking_Account::try_withdraw(double amount) noexcept
 {
     amount += per_check_fee;
-    return Account::withdraw(amount);
+    return Account::try_withdraw(amount);
+}
+
+Result Checking_Account::try_deposit(double amount) noexcept
+{
+    return Account::try_deposit(amount);
 }
 
-bool Checking_Account::deposit(double amount)
+template <typename Out>
+void Checking_Account::write_to(Out& out) const
 {
-    return Account::deposit(amount);
+    out << "[Checking_Account: " << name << ": " << Fixed{balance, 2} << "]";
 }
 
 void Checking_Account::print(std::ostream& os) const
 {
-    os.precision(2);
-    os << std::fixed;
-    os << "[Checking_Account: " << name << ": " << balance << "]";
+    write_to(os);
+}
+
+void Checking_Account::print(Print_sink& out) const
+{
+    write_to(out);
 }
 
 Savings_Account::Savings_Account(std::string name, double balance, double int_rate)
@@ -88,22 +137,31 @@ Savings_Account::Savings_Account(std::string name, double balance, double int_ra
 //      Amount supplied to deposit will be incremented by (amount * int_rate/100)
 //      and then the updated amount will be deposited
 //
-bool Savings_Account::deposit(double amount)
+Result Savings_Account::try_deposit(double amount) noexcept
 {
     amount += amount * (int_rate / 100);
-    return Account::deposit(amount);
+    return Account::try_deposit(amount);
 }
 
-bool Savings_Account::withdraw(double amount)
+Result Savings_Account::try_withdraw(double amount) noexcept
 {
-    return Account::withdraw(amount);
+    return Account::try_withdraw(amount);
+}
+
+template <typename Out>
+void Savings_Account::write_to(Out& out) const
+{
+    out << "[Savings_Account: " << name << ": " << Fixed{balance, 2} << ", " << Fixed{int_rate, 2} << "]";
 }
 
 void Savings_Account::print(std::ostream& os) const
 {
-    os.precision(2);
-    os << std::fixed;
-    os << "[Savings_Account: " << name << ": " << balance << ", " << int_rate << "]";
+    write_to(os);
+}
+
+void Savings_Account::print(Print_sink& out) const
+{
+    write_to(out);
 }
 
 Trust_Account::Trust_Account(std::string name, double balance, double int_rate)
@@ -113,38 +171,48 @@ Trust_Account::Trust_Account(std::string name, double balance, double int_rate)
 }
 
 // Deposit additional $50 bonus when amount >= $5000
-bool Trust_Account::deposit(double amount)
+Result Trust_Account::try_deposit(double amount) noexcept
 {
     if (amount >= bonus_threshold)
         amount += bonus_amount;
-    return Savings_Account::deposit(amount);
+    return Savings_Account::try_deposit(amount);
 }
 
 // Only allowed 3 withdrawals, each can be up to a maximum of 20% of the account's value
-bool Trust_Account::withdraw(double amount)
+Result Trust_Account::try_withdraw(double amount) noexcept
 {
     if (num_withdrawals >= max_withdrawals || (amount > balance * max_withdraw_percent))
-        return false;
+        return Account_error::withdrawal_limit;
     else {
         ++num_withdrawals;
-        return Savings_Account::withdraw(amount);
+        return Savings_Account::try_withdraw(amount);
     }
 }
 
+template <typename Out>
+void Trust_Account::write_to(Out& out) const
+{
+    out << "[Trust Account: " << name << ": " << Fixed{balance, 2} << ", " << Fixed{int_rate, 2}
+        << "%, withdrawals: " << num_withdrawals << "]";
+}
+
 void Trust_Account::print(std::ostream& os) const
 {
-    os.precision(2);
-    os << std::fixed;
-    os << "[Trust Account: " << name << ": " << balance << ", " << int_rate << "%, withdrawals: " << num_withdrawals
-       << "]";
+    write_to(os);
+}
+
+void Trust_Account::print(Print_sink& out) const
+{
+    write_to(out);
 }
 
 // Displays Account objects in a  vector of Account object pointers
 void display(const std::vector<Account*>& accounts)
 {
     std::cout << "\n=== Accounts===========================================" << std::endl;
+    Print_sink out{std::cout};
     for (const auto acc : accounts)
-        std::cout << *acc << std::endl;
+        out << *acc << '\n';
 }
 
 // Deposits supplied amount to each Account object in the vector
@@ -171,4 +239,26 @@ void withdraw(std::vector<Account*>& accounts, double amount)
     }
 }
 
+// Displays Account objects in an Account_store
+void display(const Account_store& accounts)
+{
+    std::cout << "\n=== Accounts===========================================" << std::endl;
+    Print_sink out{std::cout};
+    accounts.print(out);
+}
+
+// Deposits supplied amount to each Account object in the store
+void deposit(Account_store& accounts, double amount)
+{
+    std::cout << "\n=== Depositing to Accounts =================================" << std::endl;
+    accounts.deposit(amount, std::cout);
+}
+
+// Withdraw amount from each Account object in the store, an overdraft throws as with the vector
+void withdraw(Account_store& accounts, double amount)
+{
+    std::cout << "\n=== Withdrawing from Accounts ==============================" << std::endl;
+    accounts.withdraw(amount, std::cout);
+}
+
 } // namespace udemy1::s18c
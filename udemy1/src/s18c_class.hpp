@@ -1,6 +1,10 @@
 #ifndef S18C_CLASS_HPP
 #define S18C_CLASS_HPP
 
+#include "account_pool.hpp"
+#include "account_store.hpp"
+#include "print_sink.hpp"
+
 #include <iostream>
 #include <vector>
 
@@ -23,12 +27,57 @@ class InsufficentFundsException : public std::exception
     virtual const char* what() const noexcept;
 };
 
+// Why a try_deposit / try_withdraw call did not go through
+enum class Account_error {
+    none,               // no error, the call succeeded
+    negative_deposit,   // deposits must not be negative
+    insufficient_funds, // the withdrawal would make the balance negative
+    withdrawal_limit    // Trust_Account: 4th withdrawal, or more than 20% of the balance
+};
+
+const char* to_string(Account_error error);
+
+/**
+ * @class Result
+ * @file s18c_class.hpp
+ * @brief Outcome of a try_deposit / try_withdraw call
+ *        shaped like C++23 std::expected<void, Account_error>: has_value() on success, error() otherwise
+ */
+class [[nodiscard]] Result
+{
+  private:
+    Account_error err;
+
+  public:
+    constexpr Result(Account_error error = Account_error::none) noexcept
+        : err{error}
+    {
+    }
+
+    constexpr bool has_value(void) const noexcept
+    {
+        return err == Account_error::none;
+    }
+
+    constexpr explicit operator bool(void) const noexcept
+    {
+        return has_value();
+    }
+
+    constexpr Account_error error(void) const noexcept
+    {
+        return err;
+    }
+};
+
 class I_Printable
 {
     friend std::ostream& operator<<(std::ostream& os, const I_Printable& obj);
+    friend Print_sink& operator<<(Print_sink& out, const I_Printable& obj);
 
   public:
     virtual void print(std::ostream& os) const = 0;
+    virtual void print(Print_sink& out) const = 0; // the same bytes, buffered
     virtual ~I_Printable() = default;
 };
 
@@ -44,10 +93,23 @@ class Account : public I_Printable
 
   public:
     Account(std::string name = def_name, double balance = def_balance);
-    virtual bool deposit(double amount) = 0;
-    virtual bool withdraw(double amount) = 0;
+
+    // Non-throwing API, every account type implements these
+    virtual Result try_deposit(double amount) noexcept = 0;
+    virtual Result try_withdraw(double amount) noexcept = 0;
+
+    // Throwing API, thin wrappers over the try_ calls
+    // withdraw throws InsufficentFundsException on an overdraft, any other error returns false
+    bool deposit(double amount);
+    bool withdraw(double amount);
+
     virtual void print(std::ostream& os) const override;
+    virtual void print(Print_sink& out) const override;
     virtual ~Account() = default;
+
+  private:
+    template <typename Out>
+    void write_to(Out& out) const; // the one format of both prints
 };
 
 class Checking_Account : public Account
@@ -59,11 +121,16 @@ class Checking_Account : public Account
 
   public:
     Checking_Account(std::string name = def_name, double balance = def_balance);
-    virtual bool withdraw(double) override;
-    virtual bool deposit(double) override;
+    virtual Result try_withdraw(double) noexcept override;
+    virtual Result try_deposit(double) noexcept override;
     virtual void print(std::ostream& os) const override;
+    virtual void print(Print_sink& out) const override;
 
     virtual ~Checking_Account() = default;
+
+  private:
+    template <typename Out>
+    void write_to(Out& out) const; // the one format of both prints
 };
 
 class Savings_Account : public Account
@@ -78,11 +145,16 @@ class Savings_Account : public Account
 
   public:
     Savings_Account(std::string name = def_name, double balance = def_balance, double int_rate = def_int_rate);
-    virtual bool deposit(double amount) override;
-    virtual bool withdraw(double amount) override;
+    virtual Result try_deposit(double amount) noexcept override;
+    virtual Result try_withdraw(double amount) noexcept override;
     virtual void print(std::ostream& os) const override;
+    virtual void print(Print_sink& out) const override;
 
     virtual ~Savings_Account() = default;
+
+  private:
+    template <typename Out>
+    void write_to(Out& out) const; // the one format of both prints
 };
 
 class Trust_Account : public Savings_Account
@@ -103,13 +175,18 @@ class Trust_Account : public Savings_Account
     Trust_Account(std::string name = def_name, double balance = def_balance, double int_rate = def_int_rate);
 
     // Deposits of $5000.00 or more will receive $50 bonus
-    virtual bool deposit(double amount) override;
+    virtual Result try_deposit(double amount) noexcept override;
 
     // Only allowed maximum of 3 withdrawals, each can be up to a maximum of 20% of the account's value
-    virtual bool withdraw(double amount) override;
+    virtual Result try_withdraw(double amount) noexcept override;
     virtual void print(std::ostream& os) const override;
+    virtual void print(Print_sink& out) const override;
 
     virtual ~Trust_Account() = default;
+
+  private:
+    template <typename Out>
+    void write_to(Out& out) const; // the one format of both prints
 };
 
 // Utility helper functions for Account class
@@ -117,5 +194,16 @@ void display(const std::vector<Account*>& accounts);
 void deposit(std::vector<Account*>& accounts, double amount);
 void withdraw(std::vector<Account*>& accounts, double amount);
 
+// Accounts held by value in one vector, the bulk calls need no virtual dispatch
+using Account_store = udemy1::Basic_account_store<Checking_Account, Savings_Account, Trust_Account>;
+
+// Utility helper functions for Account_store, same output as the ones for std::vector<Account*>
+void display(const Account_store& accounts);
+void deposit(Account_store& accounts, double amount);
+void withdraw(Account_store& accounts, double amount);
+
+// Accounts made one after the other in an arena and released together, use them as Account*
+using Account_pool = udemy1::Basic_account_pool<Account>;
+
 } // namespace udemy1::s18c
 #endif // S18C_CLASS_HPP
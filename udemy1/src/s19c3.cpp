@@ -12,6 +12,7 @@
  *
  */
 
+#include "s19c3_search.hpp"
 #include "udemy1.hpp"
 
 #include <fstream>
@@ -0,0 +1,197 @@
+#include "s19c3_keywords.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace udemy1::s19c3
+{
+
+namespace
+{
+constexpr std::size_t lanes{4};
+constexpr std::size_t least_lane{std::size_t{1} << 12}; // shorter texts go through in one lane
+
+// where a lane of the text has got to
+struct Lane {
+    const char* p;
+    const char* end;
+    std::uint32_t row; // of the state, state * columns
+    bool after_space;
+    std::size_t words;
+};
+
+// std::isspace in the "C" locale
+inline bool is_space(char c)
+{
+    return c == ' ' || static_cast<unsigned char>(c - '\t') < 5;
+}
+} // namespace
+
+/**
+ * @brief build the trie of the distinct keywords, then fill in every missing transition
+ *        breadth first from the failure links, a state at a time
+ */
+Keyword_counter::Keyword_counter(const std::vector<std::string>& words)
+    : distinct{0}
+    , column{}
+    , columns{1}
+{
+    // the alphabet, and each keyword numbered among the distinct ones
+    std::unordered_map<std::string_view, std::uint32_t> numbers;
+    keyword_of.reserve(words.size());
+    for (const std::string& w : words) {
+        bool in_a_word{true};
+        for (const char c : w)
+            in_a_word = in_a_word && !is_space(c);
+        if (w.empty()) {
+            keyword_of.push_back(in_every_word);
+        } else if (!in_a_word) {
+            keyword_of.push_back(in_no_word);
+        } else {
+            const auto [it, added] = numbers.try_emplace(w, static_cast<std::uint32_t>(numbers.size()));
+            keyword_of.push_back(it->second);
+            if (added)
+                for (const char c : w)
+                    if (!column[static_cast<unsigned char>(c)])
+                        column[static_cast<unsigned char>(c)] = static_cast<std::uint8_t>(columns++);
+        }
+    }
+    distinct = numbers.size();
+
+    // the trie, 0 is the root and stands for no child as no transition leads back to the root in a trie
+    table.assign(columns, 0);
+    ending.assign(1, -1);
+    for (const auto& [w, number] : numbers) {
+        std::uint32_t state{0};
+        for (const char c : w) {
+            const std::size_t at{state * columns + column[static_cast<unsigned char>(c)]};
+            if (!table[at]) {
+                table[at] = static_cast<std::uint32_t>(ending.size());
+                ending.push_back(-1);
+                table.resize(table.size() + columns, 0);
+            }
+            state = table[at];
+        }
+        ending[state] = static_cast<std::int32_t>(number);
+    }
+
+    // breadth first, the failure state of a child is where its parent's failure goes on the same byte
+    const std::size_t count{ending.size()};
+    std::vector<std::uint32_t> fail(count, 0), queue;
+    output.assign(count, 0);
+    next_output.assign(count, 0);
+    queue.reserve(count);
+    for (std::size_t c{0}; c < columns; ++c)
+        if (table[c])
+            queue.push_back(table[c]); // fail 0, the root
+    for (std::size_t head{0}; head < queue.size(); ++head) {
+        const std::uint32_t state{queue[head]};
+        const std::uint32_t f{fail[state]};
+        next_output[state] = output[f];
+        output[state] = (ending[state] >= 0) ? state : next_output[state];
+        for (std::size_t c{0}; c < columns; ++c) {
+            std::uint32_t& to{table[state * columns + c]};
+            const std::uint32_t via_fail{table[f * columns + c]};
+            if (to) {
+                fail[to] = via_fail;
+                queue.push_back(to);
+            } else {
+                to = via_fail;
+            }
+        }
+    }
+
+    // entries hold the row of the next state, the scan needs no multiply
+    if (table.size() >= has_output)
+        throw std::length_error("Keyword_counter: the keywords need a table of more than 2^31 entries");
+    for (std::uint32_t& to : table)
+        to = static_cast<std::uint32_t>(to * columns) | (output[to] ? has_output : 0);
+}
+
+std::size_t Keyword_counter::size(void) const
+{
+    return keyword_of.size();
+}
+
+std::size_t Keyword_counter::states(void) const
+{
+    return ending.size();
+}
+
+std::size_t Keyword_counter::table_bytes(void) const
+{
+    return table.size() * sizeof(std::uint32_t);
+}
+
+/**
+ * @brief one table step per byte, a keyword found again in the same word is not counted again
+ *
+ * Each step waits for the table load of the one before, so the text is cut at whitespace
+ * into lanes that are stepped through side by side, their loads overlap. Each lane keeps
+ * its own record of the word a keyword was last counted in.
+ */
+std::size_t Keyword_counter::count(std::string_view text, std::vector<std::size_t>& counts) const
+{
+    std::vector<std::size_t> found(distinct, 0);
+    std::vector<std::size_t> last_word(distinct * lanes, 0); // per lane, the word a keyword was last counted in
+    const std::uint32_t* const next{table.data()};
+    const std::uint8_t* const col{column};
+    const std::size_t width{columns};
+
+    const std::size_t n{text.size()};
+    const std::size_t used{n >= lanes * least_lane ? lanes : 1};
+    Lane lane[lanes];
+    for (std::size_t l{0}, from{0}; l < lanes; ++l) {
+        std::size_t to{(l + 1 >= used) ? n : std::max(n / used * (l + 1), from)};
+        while (to < n && !is_space(text[to]))
+            ++to;
+        lane[l] = Lane{text.data() + from, text.data() + to, 0, true, 0};
+        from = to;
+    }
+
+    const auto step{[&](Lane& ln, std::size_t l) {
+        const char c{*ln.p++};
+        const bool space{is_space(c)};
+        ln.words += !space && ln.after_space;
+        ln.after_space = space;
+
+        const std::uint32_t to{next[ln.row + col[static_cast<unsigned char>(c)]]};
+        ln.row = to & ~has_output;
+        if (to & has_output) {
+            for (std::uint32_t s{output[ln.row / width]}; s; s = next_output[s]) {
+                const std::size_t k{static_cast<std::size_t>(ending[s])};
+                std::size_t& last{last_word[k * lanes + l]};
+                if (last != ln.words) { // the lane is in its word ln.words, counted from 1
+                    last = ln.words;
+                    ++found[k];
+                }
+            }
+        }
+    }};
+
+    std::size_t together{n};
+    for (const Lane& ln : lane)
+        together = std::min(together, static_cast<std::size_t>(ln.end - ln.p));
+    for (std::size_t i{0}; i < together; ++i) {
+#pragma GCC unroll 4
+        for (std::size_t l = 0; l < lanes; ++l)
+            step(lane[l], l);
+    }
+
+    std::size_t words{0};
+    for (std::size_t l{0}; l < lanes; ++l) {
+        while (lane[l].p < lane[l].end)
+            step(lane[l], l);
+        words += lane[l].words;
+    }
+
+    counts.resize(keyword_of.size());
+    for (std::size_t i{0}; i < keyword_of.size(); ++i) {
+        const std::uint32_t k{keyword_of[i]};
+        counts[i] = (k == in_no_word) ? 0 : (k == in_every_word) ? words : found[k];
+    }
+    return words;
+}
+
+} // namespace udemy1::s19c3
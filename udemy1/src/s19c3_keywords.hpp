@@ -0,0 +1,56 @@
+#ifndef S19C3_KEYWORDS_HPP
+#define S19C3_KEYWORDS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace udemy1::s19c3
+{
+
+/**
+ * @class Keyword_counter
+ * @file s19c3_keywords.hpp
+ * @brief find_word_count for many targets at once, in one pass over the text
+ *        counts[i] is the number of words that contain keywords[i], the same as
+ *        count_words(text, keywords[i]).matches.
+ *
+ *        Built once into an Aho-Corasick automaton with every transition filled in, so the
+ *        scan is one table load per byte. The bytes that appear in the keywords are the
+ *        alphabet, all the others share one column, a state is a row of the table. The top
+ *        bit of an entry tells whether some keyword ends in the state it leads to, only then
+ *        the outputs are looked at.
+ */
+class Keyword_counter
+{
+  private:
+    static constexpr std::uint32_t has_output{std::uint32_t{1} << 31};
+    static constexpr std::uint32_t in_no_word{~std::uint32_t{0}};    // a keyword with whitespace in it
+    static constexpr std::uint32_t in_every_word{~std::uint32_t{1}}; // the empty keyword
+
+    std::vector<std::uint32_t> keyword_of; // each keyword, its number among the distinct ones
+    std::size_t distinct;
+    std::uint8_t column[256];          // byte to alphabet column, 0 for the bytes no keyword has
+    std::size_t columns;
+    std::vector<std::uint32_t> table;  // state * columns + column, the next state * columns | has_output
+    std::vector<std::int32_t> ending;  // the distinct keyword that ends in the state, -1 for none
+    std::vector<std::uint32_t> output; // the state itself or the nearest suffix state with a keyword ending
+    std::vector<std::uint32_t> next_output; // the next suffix state with a keyword ending, 0 for none
+
+  public:
+    // throws std::length_error when the table would need more than 2^31 entries
+    explicit Keyword_counter(const std::vector<std::string>& keywords);
+
+    std::size_t size(void) const;        // number of keywords
+    std::size_t states(void) const;      // of the automaton
+    std::size_t table_bytes(void) const; // memory of the transition table
+
+    // counts[i] = words of text that contain keyword i, returns the number of words
+    std::size_t count(std::string_view text, std::vector<std::size_t>& counts) const;
+};
+
+} // namespace udemy1::s19c3
+
+#endif // S19C3_KEYWORDS_HPP
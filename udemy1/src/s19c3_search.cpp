@@ -0,0 +1,212 @@
+#include "s19c3_search.hpp"
+
+#include "mapped_file.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <omp.h>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define S19C3_SEARCH_X86 1
+#include <immintrin.h>
+#endif
+
+namespace udemy1::s19c3
+{
+
+namespace
+{
+constexpr std::size_t least_piece{std::size_t{1} << 20}; // smaller pieces are not worth a thread
+constexpr std::size_t pieces_per_thread{4};              // evens out pieces that take longer
+
+// std::isspace in the "C" locale, what operator>> splits the words on
+inline bool is_space(char c)
+{
+    return c == ' ' || static_cast<unsigned char>(c - '\t') < 5;
+}
+
+// where the word that goes on at from ends
+std::size_t end_of_word(const char* s, std::size_t from, std::size_t n)
+{
+    while (from < n && !is_space(s[from]))
+        ++from;
+    return from;
+}
+
+// where a scan has got to, the vector loop hands it over to the scalar one for the tail
+struct Scan {
+    const char* s;
+    std::size_t n;
+    std::string_view target; // not empty, no whitespace in it
+    bool after_space;        // the byte before the next one is whitespace, or there is none
+    std::size_t word_end;    // a match before it is in a word counted already
+    Word_count count;
+};
+
+template <bool Search>
+void scan_scalar(Scan& sc, std::size_t i)
+{
+    const std::size_t k{sc.target.size()};
+    for (; i < sc.n; ++i) {
+        const bool space{is_space(sc.s[i])};
+        sc.count.words += !space && sc.after_space;
+        sc.after_space = space;
+        if (Search && i >= sc.word_end && sc.s[i] == sc.target[0] && sc.n - i >= k &&
+            std::memcmp(sc.s + i, sc.target.data(), k) == 0) {
+            ++sc.count.matches;
+            sc.word_end = end_of_word(sc.s, i + k, sc.n);
+        }
+    }
+}
+
+template <bool Search>
+void scan_at_scalar(Scan& sc)
+{
+    scan_scalar<Search>(sc, 0);
+}
+
+#ifdef S19C3_SEARCH_X86
+/**
+ * @brief 32 bytes a step, everything kept as bit masks of the step
+ *        A word starts at a byte that is not whitespace after one that is. A match can only
+ *        start where the first byte of the target matches and, k - 1 bytes further on, its
+ *        last byte does too, only those places are compared in full, and with k <= 2 the two
+ *        compares are the match. Of the matches in a word only the first counts: adding the
+ *        matches to the word mask carries from each first match to the end of its word,
+ *        covering everything after it.
+ */
+template <bool Search>
+[[gnu::target("avx2,popcnt")]] void scan_at_avx2(Scan& sc)
+{
+    const char* const s{sc.s};
+    const std::size_t n{sc.n};
+    const std::size_t k{Search ? sc.target.size() : 1};
+    const char* const middle{sc.target.data() + 1};
+
+    const __m256i blank = _mm256_set1_epi8(' ');
+    const __m256i bias = _mm256_set1_epi8(static_cast<char>(128 - '\t')); // '\t' to '\r' become the 5 lowest
+    const __m256i limit = _mm256_set1_epi8(static_cast<char>(-128 + 5));
+    const __m256i first = _mm256_set1_epi8(Search ? sc.target.front() : 0);
+    const __m256i last = _mm256_set1_epi8(Search ? sc.target.back() : 0);
+
+    std::uint32_t after_space{sc.after_space ? 1u : 0u};
+    std::uint32_t covered_in{sc.word_end > 0 ? 1u : 0u}; // the word going on into the step has a match
+    std::size_t words{0}, matches{0};
+
+    std::size_t i{0};
+    for (; i + k - 1 + 32 <= n; i += 32) {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + i));
+        const __m256i white =
+            _mm256_or_si256(_mm256_cmpeq_epi8(v, blank), _mm256_cmpgt_epi8(limit, _mm256_add_epi8(v, bias)));
+        const std::uint32_t space{static_cast<std::uint32_t>(_mm256_movemask_epi8(white))};
+        words += static_cast<std::size_t>(_mm_popcnt_u32(~space & ((space << 1) | after_space)));
+        after_space = space >> 31;
+
+        if (Search) {
+            const __m256i end = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + i + k - 1));
+            std::uint32_t found{static_cast<std::uint32_t>(
+                _mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(v, first), _mm256_cmpeq_epi8(end, last))))};
+            if (k > 2)
+                for (std::uint32_t c{found}; c; c &= c - 1) {
+                    const int b{__builtin_ctz(c)};
+                    if (std::memcmp(s + i + b + 1, middle, k - 2) != 0)
+                        found &= ~(1u << b);
+                }
+            const std::uint32_t word{~space};
+            const std::uint32_t seeds{found | (covered_in & word)};
+            const std::uint32_t covered{(word & ~(word + seeds)) | seeds}; // first match to the end of its word
+            matches += static_cast<std::size_t>(_mm_popcnt_u32(found & ~((covered << 1) | covered_in)));
+            covered_in = covered >> 31;
+        }
+    }
+
+    sc.after_space = after_space;
+    sc.word_end = covered_in ? end_of_word(s, i, n) : 0;
+    sc.count.words += words;
+    sc.count.matches += matches;
+    scan_scalar<Search>(sc, i);
+}
+#endif // S19C3_SEARCH_X86
+
+// kernels picked once, on the first count
+using scan_fn = void (*)(Scan&);
+
+struct Kernels {
+    scan_fn words;
+    scan_fn search;
+};
+
+const Kernels& best_scan(void)
+{
+    static const Kernels kernels{[] {
+#ifdef S19C3_SEARCH_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("popcnt"))
+            return Kernels{scan_at_avx2<false>, scan_at_avx2<true>};
+#endif
+        return Kernels{scan_at_scalar<false>, scan_at_scalar<true>};
+    }()};
+    return kernels;
+}
+} // namespace
+
+Word_count count_words(std::string_view text, std::string_view target)
+{
+    bool search{!target.empty()};
+    for (const char c : target)
+        if (is_space(c))
+            search = false; // no word can hold it
+
+    Scan sc{text.data(), text.size(), target, true, 0, Word_count{0, 0}};
+    (search ? best_scan().search : best_scan().words)(sc);
+    if (target.empty())
+        sc.count.matches = sc.count.words; // "" is found in every word
+    return sc.count;
+}
+
+Word_count count_words_parallel(std::string_view text, std::string_view target, int threads)
+{
+    if (threads <= 0)
+        threads = omp_get_max_threads();
+
+    const std::size_t n{text.size()};
+    const std::size_t pieces{std::clamp<std::size_t>(n / least_piece, 1, threads * pieces_per_thread)};
+    if (pieces == 1)
+        return count_words(text, target);
+
+    // each cut moves on to the next whitespace, a cut inside a long word may meet the next one
+    std::vector<std::size_t> cut(pieces + 1, n);
+    cut[0] = 0;
+    for (std::size_t p{1}; p < pieces; ++p) {
+        std::size_t c{std::max(n / pieces * p, cut[p - 1])};
+        while (c < n && !is_space(text[c]))
+            ++c;
+        cut[p] = c;
+    }
+
+    std::size_t words{0}, matches{0};
+#pragma omp parallel for num_threads(threads) schedule(dynamic) reduction(+ : words, matches)
+    for (std::size_t p = 0; p < pieces; ++p) {
+        const Word_count count{count_words(text.substr(cut[p], cut[p + 1] - cut[p]), target)};
+        words += count.words;
+        matches += count.matches;
+    }
+    return Word_count{words, matches};
+}
+
+int find_word_count_mapped(std::string file_name, std::string target_word, int threads)
+{
+    const Mapped_file file{file_name};
+    if (!file.is_open()) {
+        std::cerr << "File open error." << std::endl;
+        return 0;
+    }
+    const Word_count count{count_words_parallel(file.text(), target_word, threads)};
+    std::cout << count.words << " words were searched..." << std::endl;
+    return static_cast<int>(count.matches);
+}
+
+} // namespace udemy1::s19c3
@@ -0,0 +1,44 @@
+#ifndef S19C3_SEARCH_HPP
+#define S19C3_SEARCH_HPP
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace udemy1::s19c3
+{
+
+// what find_word_count works out, the words read and how many contain the target
+struct Word_count {
+    std::size_t words;
+    std::size_t matches;
+};
+
+/**
+ * @brief Count the words of text and the words that contain target anywhere in them
+ *        The same counts as reading the text with std::istream >> std::string and calling
+ *        word.find(target) on each word: words are split on the whitespace of the "C" locale,
+ *        a word with several matches counts once, an empty target matches every word and a
+ *        target with whitespace in it matches none.
+ *        One pass over the text, 32 bytes at a time with AVX2: the word starts come from a
+ *        whitespace mask, the places where the first and the last byte of target both match
+ *        are the only ones compared in full.
+ */
+Word_count count_words(std::string_view text, std::string_view target);
+
+/**
+ * @brief count_words over several threads (0 uses the OpenMP default), the same result
+ *        The text is cut into pieces at whitespace, so no word is split between two pieces,
+ *        each piece is counted on its own and the counts are added up.
+ */
+Word_count count_words_parallel(std::string_view text, std::string_view target, int threads = 0);
+
+// the original, reads the file word by word, prints the words searched, returns the matches
+int find_word_count(std::string file_name, std::string target_word);
+
+// the same output and result, the file is mapped and counted by count_words_parallel
+int find_word_count_mapped(std::string file_name, std::string target_word, int threads = 1);
+
+} // namespace udemy1::s19c3
+
+#endif // S19C3_SEARCH_HPP
@@ -81,6 +81,8 @@
  *
  */
 
+#include "s20c3_count.hpp"
+#include "s20c3_index.hpp"
 #include "udemy1.hpp"
 
 #include <fstream>
@@ -90,6 +92,7 @@
 #include <set>
 #include <sstream>
 #include <string>
+#include <vector>
 
 namespace udemy1::s20c3
 {
@@ -199,3 +202,54 @@ void udemy1::s20c3_run(void)
     // display each unique word, displayed in ascending order and the line numbers
     udemy1::s20c3::part2(filename);
 }
+
+int udemy1::s20c3_index_main(int argc, const char* const argv[])
+{
+    const std::vector<std::string> args(argv, argv + argc);
+    if (args.size() == 3 && args[0] == "index") {
+        const Mapped_file file{args[1]};
+        if (!file.is_open()) {
+            std::cerr << "Error opening input file" << std::endl;
+            return 1;
+        }
+        const s20c3::Line_index index{s20c3::build_index(file.text())};
+        if (!index.save(args[2])) {
+            std::cerr << "Error writing index file" << std::endl;
+            return 1;
+        }
+        std::cout << index.size() << " words, " << index.size_postings() << " (word, line) pairs written to "
+                  << args[2] << std::endl;
+        return 0;
+    }
+    if (args.size() == 3 && args[0] == "update") {
+        if (!s20c3::update_index(args[1], args[2])) {
+            std::cerr << "Error updating index file" << std::endl;
+            return 1;
+        }
+        const s20c3::Line_index index{args[2]};
+        std::cout << index.size() << " words, " << index.size_postings() << " (word, line) pairs of "
+                  << index.text_end().bytes << " bytes in " << args[2] << std::endl;
+        return 0;
+    }
+    if (args.size() >= 3 && args[0] == "query") {
+        const s20c3::Line_index index{args[1]};
+        if (!index.is_open()) {
+            std::cerr << "Error opening index file" << std::endl;
+            return 1;
+        }
+        std::string query;
+        for (std::size_t i{2}; i < args.size(); ++i)
+            query += args[i] + " ";
+        const std::vector<std::uint32_t> lines{s20c3::find_lines(index, query)};
+        std::cout << lines.size() << " lines [ ";
+        for (const std::uint32_t line : lines)
+            std::cout << line << " ";
+        std::cout << "]" << std::endl;
+        return 0;
+    }
+    std::cerr << "usage: s20c3 index <text file> <index file>\n"
+                 "       s20c3 update <text file> <index file>\n"
+                 "       s20c3 query <index file> <word>... [OR <word>...]..."
+              << std::endl;
+    return 2;
+}
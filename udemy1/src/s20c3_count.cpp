@@ -0,0 +1,652 @@
+#include "s20c3_count.hpp"
+
+#include "mapped_file.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <omp.h>
+#include <utility>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define S20C3_COUNT_X86 1
+#include <immintrin.h>
+#endif
+
+namespace udemy1::s20c3
+{
+
+namespace
+{
+constexpr std::size_t first_slots{1 << 12};
+
+// what a byte is to the tokenizer
+enum Kind : std::uint8_t { kept = 0, dropped = 1, space = 2 };
+
+constexpr struct Kinds {
+    std::uint8_t of[256];
+    constexpr Kinds()
+        : of{}
+    {
+        for (unsigned char c : {' ', '\t', '\n', '\v', '\f', '\r'})
+            of[c] = space;
+        for (unsigned char c : {'.', ',', ';', ':'})
+            of[c] = dropped;
+    }
+} kinds;
+
+constexpr std::uint64_t hash_seed{0x9E3779B97F4A7C15ull};
+
+inline std::uint64_t load(const char* p)
+{
+    std::uint64_t v;
+    std::memcpy(&v, p, 8);
+    return v;
+}
+
+inline std::uint64_t mix(std::uint64_t h, std::uint64_t v)
+{
+    h = (h ^ v) * 0xBF58476D1CE4E5B9ull;
+    return h ^ (h >> 31);
+}
+
+inline std::uint64_t finish(std::uint64_t h, std::uint64_t v)
+{
+    h = (h ^ v) * 0x94D049BB133111EBull;
+    return h ^ (h >> 29);
+}
+} // namespace
+
+Word_table::Word_table()
+    : slots(first_slots, Slot{0, 0, 0, 0})
+    , used{0}
+{
+}
+
+void Word_table::grow(void)
+{
+    std::vector<Slot> old(slots.size() * 2, Slot{0, 0, 0, 0});
+    old.swap(slots);
+    const std::size_t mask{slots.size() - 1};
+    for (const Slot& s : old)
+        if (s.count) {
+            std::size_t i{s.hash & mask};
+            while (slots[i].count)
+                i = (i + 1) & mask;
+            slots[i] = s;
+        }
+}
+
+void Word_table::add(std::string_view word, std::uint64_t hash, std::size_t n)
+{
+    const std::size_t mask{slots.size() - 1};
+    std::size_t i{hash & mask};
+    for (;; i = (i + 1) & mask) {
+        Slot& s{slots[i]};
+        if (!s.count)
+            break;
+        // up to 8 bytes the same hash and length is the same word, see hash_word
+        if (s.hash == hash && s.length == word.size() &&
+            (word.size() <= 8 || std::memcmp(arena.data() + s.offset, word.data(), word.size()) == 0)) {
+            s.count += n;
+            return;
+        }
+    }
+
+    slots[i] = Slot{hash, arena.size(), word.size(), n};
+    arena.insert(arena.end(), word.begin(), word.end());
+    if (++used * 2 > slots.size()) // at most half full, the probes stay short
+        grow();
+}
+
+std::size_t Word_table::size(void) const
+{
+    return used;
+}
+
+std::size_t Word_table::memory(void) const
+{
+    return slots.capacity() * sizeof(Slot) + arena.capacity();
+}
+
+std::vector<Word_table::Entry> Word_table::sorted(void) const&
+{
+    std::vector<Entry> entries;
+    entries.reserve(used);
+    for (const Slot& s : slots)
+        if (s.count)
+            entries.push_back(Entry{std::string_view{arena.data() + s.offset, s.length}, s.count});
+    std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) { return a.word < b.word; });
+    return entries;
+}
+
+Line_table::Line_table()
+    : slots(first_slots, Slot{0, 0, 0, 0, 0, 0})
+    , postings{0}
+{
+}
+
+void Line_table::grow(void)
+{
+    std::vector<Slot> old(slots.size() * 2, Slot{0, 0, 0, 0, 0, 0});
+    old.swap(slots);
+    const std::size_t mask{slots.size() - 1};
+    for (const Slot& s : old)
+        if (s.word) {
+            std::size_t i{s.hash & mask};
+            while (slots[i].word)
+                i = (i + 1) & mask;
+            slots[i] = s;
+        }
+}
+
+Line_table::Slot& Line_table::find(std::string_view word, std::uint64_t hash)
+{
+    const std::size_t mask{slots.size() - 1};
+    std::size_t i{hash & mask};
+    for (;; i = (i + 1) & mask) {
+        Slot& s{slots[i]};
+        if (!s.word)
+            break;
+        // up to 8 bytes the same hash and length is the same word, see hash_word
+        if (s.hash == hash && s.length == word.size() &&
+            (word.size() <= 8 || std::memcmp(arena.data() + s.offset, word.data(), word.size()) == 0))
+            return s;
+    }
+
+    lines.emplace_back();
+    slots[i] = Slot{hash, arena.size(), static_cast<std::uint32_t>(word.size()),
+        static_cast<std::uint32_t>(lines.size()), 0, 0};
+    arena.insert(arena.end(), word.begin(), word.end());
+    if (lines.size() * 2 > slots.size()) { // at most half full, the probes stay short
+        grow();
+        return find(word, hash);
+    }
+    return slots[i];
+}
+
+void Line_table::add(std::string_view word, std::uint64_t hash, std::span<const std::uint32_t> more,
+    std::uint32_t shift, std::size_t count)
+{
+    if (more.empty())
+        return;
+    Slot& s{find(word, hash)};
+    s.count += static_cast<std::uint32_t>(count);
+    std::vector<std::uint32_t>& to{lines[s.word - 1]};
+    to.reserve(to.size() + more.size());
+    for (const std::uint32_t line : more)
+        to.push_back(line + shift);
+    s.last = to.back();
+    postings += more.size();
+}
+
+std::size_t Line_table::size(void) const
+{
+    return lines.size();
+}
+
+std::size_t Line_table::size_postings(void) const
+{
+    return postings;
+}
+
+std::size_t Line_table::memory(void) const
+{
+    std::size_t bytes{slots.capacity() * sizeof(Slot) + arena.capacity() +
+                      lines.capacity() * sizeof(std::vector<std::uint32_t>)};
+    for (const std::vector<std::uint32_t>& l : lines)
+        bytes += l.capacity() * sizeof(std::uint32_t);
+    return bytes;
+}
+
+std::vector<Line_table::Entry> Line_table::sorted(void) const&
+{
+    std::vector<Entry> entries;
+    entries.reserve(lines.size());
+    for_each([&](std::string_view word, std::uint64_t, Seen seen) {
+        entries.push_back(Entry{word, seen.lines, seen.count});
+    });
+    std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) { return a.word < b.word; });
+    return entries;
+}
+
+/**
+ * @brief 8 bytes at a time, each mixed in with a multiply, the last 1 to 8 bytes are finished
+ *        with another. Both steps are one to one, two words of up to 8 bytes with the same
+ *        length and hash are the same word.
+ */
+std::uint64_t hash_word(std::string_view word)
+{
+    const char* p{word.data()};
+    std::size_t n{word.size()};
+    std::uint64_t h{hash_seed ^ n};
+    for (; n > 8; p += 8, n -= 8)
+        h = mix(h, load(p));
+    std::uint64_t v{0};
+    std::memcpy(&v, p, n);
+    return finish(h, v);
+}
+
+namespace
+{
+constexpr std::size_t least_piece{std::size_t{1} << 20}; // smaller pieces are not worth a thread
+
+// what part1 and part2 do with each word: count it, or note the line it is on
+struct Counting {
+    static constexpr bool by_line{false};
+    Word_table& table;
+    std::string cleaned; // reused for the words with bytes to clean out
+
+    void operator()(std::string_view word, std::uint64_t hash, std::uint32_t)
+    {
+        table.add(word, hash);
+    }
+};
+
+struct Indexing {
+    static constexpr bool by_line{true};
+    Line_table& table;
+    std::string cleaned;
+
+    void operator()(std::string_view word, std::uint64_t hash, std::uint32_t line)
+    {
+        table.add(word, hash, line);
+    }
+};
+
+// the n bytes at first as they are, end is that of the text
+template <typename Sink>
+inline void add_kept(Sink& sink, const char* first, std::size_t n, const char* end, std::uint32_t line)
+{
+    if (n - 1 < 8 && end - first >= 8) // most words, 1 to 8 bytes hashed from one load
+        sink({first, n}, finish(hash_seed ^ n, load(first) & (~std::uint64_t{0} >> (64 - 8 * n))), line);
+    else
+        sink({first, n}, hash_word({first, n}), line);
+}
+
+// the word in [first, last) cleaned of the bytes clean_string takes out
+template <typename Sink>
+void add_cleaned(Sink& sink, const char* first, const char* last, std::uint32_t line)
+{
+    sink.cleaned.clear();
+    for (const char* p{first}; p < last; ++p)
+        if (kinds.of[static_cast<unsigned char>(*p)] == kept)
+            sink.cleaned += *p;
+    sink(sink.cleaned, hash_word(sink.cleaned), line);
+}
+
+// the word in [first, last), has_dropped if there are bytes in it to clean out
+template <typename Sink>
+inline void add_word(Sink& sink, const char* first, const char* last, const char* end, bool has_dropped,
+    std::uint32_t line)
+{
+    if (has_dropped) {
+        // mostly a , . ; or : after the word, it is left out without a copy
+        while (last > first && kinds.of[static_cast<unsigned char>(last[-1])] == dropped)
+            --last;
+        const char* p{first};
+        while (p < last && kinds.of[static_cast<unsigned char>(*p)] != dropped)
+            ++p;
+        if (p < last)
+            return add_cleaned(sink, first, last, line);
+    }
+    add_kept(sink, first, static_cast<std::size_t>(last - first), end, line);
+}
+
+// the words of [p, end) to sink, line is that of p, returns the line of end
+template <typename Sink>
+std::uint32_t split_scalar(const char* p, const char* end, Sink& sink, std::uint32_t line)
+{
+    for (;;) {
+        for (; p < end && kinds.of[static_cast<unsigned char>(*p)] == space; ++p)
+            if (Sink::by_line && *p == '\n')
+                ++line;
+        if (p == end)
+            break;
+
+        const char* const first{p};
+        std::uint8_t seen{kept};
+        for (std::uint8_t k; p < end && (k = kinds.of[static_cast<unsigned char>(*p)]) != space; ++p)
+            seen |= k;
+        add_word(sink, first, p, end, seen == dropped, line);
+    }
+    return line;
+}
+
+#ifdef S20C3_COUNT_X86
+// one bit for each of the 64 bytes in lo and hi that is whitespace in the "C" locale
+[[gnu::target("avx2")]] inline std::uint64_t space_mask(__m256i lo, __m256i hi)
+{
+    const __m256i blank = _mm256_set1_epi8(' ');
+    const __m256i bias = _mm256_set1_epi8(static_cast<char>(128 - '\t')); // '\t' to '\r' become the 5 lowest
+    const __m256i limit = _mm256_set1_epi8(static_cast<char>(-128 + 5));
+    const __m256i l = _mm256_or_si256(_mm256_cmpeq_epi8(lo, blank), _mm256_cmpgt_epi8(limit, _mm256_add_epi8(lo, bias)));
+    const __m256i h = _mm256_or_si256(_mm256_cmpeq_epi8(hi, blank), _mm256_cmpgt_epi8(limit, _mm256_add_epi8(hi, bias)));
+    return static_cast<std::uint32_t>(_mm256_movemask_epi8(l)) |
+           static_cast<std::uint64_t>(static_cast<std::uint32_t>(_mm256_movemask_epi8(h))) << 32;
+}
+
+// and one for each that clean_string takes out
+[[gnu::target("avx2")]] inline __m256i dropped_bytes(__m256i v)
+{
+    return _mm256_or_si256(
+        _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('.')), _mm256_cmpeq_epi8(v, _mm256_set1_epi8(','))),
+        _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8(';')), _mm256_cmpeq_epi8(v, _mm256_set1_epi8(':'))));
+}
+
+[[gnu::target("avx2")]] inline std::uint64_t dropped_mask(__m256i lo, __m256i hi)
+{
+    return static_cast<std::uint32_t>(_mm256_movemask_epi8(dropped_bytes(lo))) |
+           static_cast<std::uint64_t>(static_cast<std::uint32_t>(_mm256_movemask_epi8(dropped_bytes(hi)))) << 32;
+}
+
+// and one for each '\n'
+[[gnu::target("avx2")]] inline std::uint64_t newline_mask(__m256i lo, __m256i hi)
+{
+    const __m256i newline = _mm256_set1_epi8('\n');
+    return static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(lo, newline))) |
+           static_cast<std::uint64_t>(static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(hi, newline))))
+               << 32;
+}
+
+[[gnu::target("popcnt")]] inline std::uint32_t ones(std::uint64_t bits)
+{
+    return static_cast<std::uint32_t>(_mm_popcnt_u64(bits));
+}
+
+inline std::uint64_t below(int b)
+{
+    return (std::uint64_t{1} << b) - 1;
+}
+
+/**
+ * @brief 64 bytes a step, the whitespace and the bytes to clean out each become a bit mask
+ *        and only the bits where a word starts or ends are walked, a word at a time rather than
+ *        a byte. The line of a word is the line of the step and the '\n' before it in the step.
+ *        A word still going on at the tail is left to the scalar loop.
+ */
+template <typename Sink>
+[[gnu::target("avx2,bmi,popcnt")]] std::uint32_t split_avx2(const char* s, const char* end, Sink& sink,
+    std::uint32_t line)
+{
+    const char* first{nullptr}; // of the word going on, if any
+    std::uint32_t first_line{0}; // its line
+    std::uint64_t word_in{0};    // the byte before the step is in a word
+    bool dropped_in{false};      // the word going on has had bytes to clean out
+
+    for (; end - s >= 64; s += 64) {
+        const __m256i lo = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s));
+        const __m256i hi = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + 32));
+        const std::uint64_t drop{dropped_mask(lo, hi)};
+        const std::uint64_t word{~space_mask(lo, hi)};
+        const std::uint64_t newline{Sink::by_line ? newline_mask(lo, hi) : 0};
+        const std::uint64_t edges{word ^ ((word << 1) | word_in)}; // starts and ends, in turn
+        word_in = word >> 63;
+
+        std::uint64_t e{edges};
+        if (first) { // the word going on ends at the first edge, or goes on past the step
+            if (!e) {
+                dropped_in |= drop != 0;
+                continue;
+            }
+            const int b{__builtin_ctzll(e)};
+            add_word(sink, first, s + b, end, dropped_in || (drop & below(b)), first_line);
+            e &= e - 1;
+            first = nullptr;
+        }
+        while (e) {
+            const int b{__builtin_ctzll(e)};
+            e &= e - 1;
+            if (!e) { // goes on into the next step
+                first = s + b;
+                first_line = line + ones(newline & below(b));
+                dropped_in = (drop >> b) != 0;
+                break;
+            }
+            const int c{__builtin_ctzll(e)};
+            e &= e - 1;
+            // the bytes to clean out, length is what is left when they all come after the rest
+            const std::uint64_t in_word{drop & ~below(b) & below(c)};
+            const int length{c - b - static_cast<int>(ones(in_word))};
+            const std::uint32_t at{line + ones(newline & below(b))};
+            if (in_word == (~below(b + length) & below(c)))
+                add_kept(sink, s + b, static_cast<std::size_t>(length), end, at);
+            else
+                add_cleaned(sink, s + b, s + c, at);
+        }
+        line += ones(newline);
+    }
+    return first ? split_scalar(first, end, sink, first_line) : split_scalar(s, end, sink, line);
+}
+#endif // S20C3_COUNT_X86
+
+// the kernels picked once, on the first split
+template <typename Sink>
+using split_fn = std::uint32_t (*)(const char*, const char*, Sink&, std::uint32_t);
+
+struct Kernels {
+    split_fn<Counting> count;
+    split_fn<Indexing> index;
+};
+
+const Kernels& best_split(void)
+{
+    static const Kernels kernels{[] {
+#ifdef S20C3_COUNT_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("bmi") &&
+            __builtin_cpu_supports("popcnt"))
+            return Kernels{split_avx2<Counting>, split_avx2<Indexing>};
+#endif
+        return Kernels{split_scalar<Counting>, split_scalar<Indexing>};
+    }()};
+    return kernels;
+}
+
+// a word of the table of a piece, on its way to the part its hash falls in
+template <typename Value>
+struct Handed {
+    std::string_view word;
+    std::uint64_t hash;
+    Value value; // its count or its lines
+};
+
+/**
+ * @brief The map-reduce of count_words_parallel and index_words_parallel
+ *        fill(piece, table) puts the words of one piece into its table and returns the lines of
+ *        the piece, merge(part, handed, shift) adds a word of a piece to the part it is handed to,
+ *        shift is the lines of the pieces before. lines is set to the lines of all the pieces.
+ */
+template <typename Table, typename Value, typename Fill, typename Merge>
+std::vector<Table> by_parts(std::string_view text, int threads, Fill fill, Merge merge, std::uint32_t& lines)
+{
+    if (threads <= 0)
+        threads = omp_get_max_threads();
+
+    // the pieces start on a line of their own, a long line may take in the next cut
+    const std::size_t n{text.size()};
+    const std::size_t pieces{std::clamp<std::size_t>(n / least_piece, 1, static_cast<std::size_t>(threads))};
+    std::vector<std::size_t> cut(pieces + 1, n);
+    cut[0] = 0;
+    for (std::size_t p{1}; p < pieces; ++p) {
+        const std::size_t newline{text.find('\n', std::max(n / pieces * p, cut[p - 1]))};
+        cut[p] = newline == std::string_view::npos ? n : newline + 1;
+    }
+
+    std::vector<Table> tables(pieces);
+    std::vector<std::uint32_t> shift(pieces, 0);
+    std::vector<std::vector<std::vector<Handed<Value>>>> handed(pieces); // by piece, then by part
+#pragma omp parallel for num_threads(threads) schedule(static)
+    for (std::size_t p = 0; p < pieces; ++p) {
+        shift[p] = fill(text.substr(cut[p], cut[p + 1] - cut[p]), tables[p]);
+        if (pieces > 1) {
+            handed[p].resize(pieces);
+            tables[p].for_each([&](std::string_view word, std::uint64_t hash, Value value) {
+                handed[p][(hash >> 32) % pieces].push_back(Handed<Value>{word, hash, value});
+            });
+        }
+    }
+    lines = 0;
+    if (pieces == 1) {
+        lines = shift[0];
+        return tables;
+    }
+
+    for (std::uint32_t& s : shift)
+        lines += std::exchange(s, lines);
+
+    std::vector<Table> parts(pieces);
+#pragma omp parallel for num_threads(threads) schedule(static)
+    for (std::size_t q = 0; q < pieces; ++q)
+        for (std::size_t p = 0; p < pieces; ++p)
+            for (const Handed<Value>& h : handed[p][q])
+                merge(parts[q], h, shift[p]);
+    return parts;
+}
+
+// sorted() of every part on a thread of its own, then the sorted runs merged two at a time
+template <typename Table>
+std::vector<typename Table::Entry> sorted_parts(const std::vector<Table>& parts)
+{
+    using Entry = typename Table::Entry;
+    std::vector<std::vector<Entry>> runs(parts.size());
+#pragma omp parallel for schedule(dynamic)
+    for (std::size_t p = 0; p < parts.size(); ++p)
+        runs[p] = parts[p].sorted();
+
+    std::vector<Entry> entries;
+    std::vector<std::size_t> bounds{0};
+    for (const std::vector<Entry>& run : runs) {
+        entries.insert(entries.end(), run.begin(), run.end());
+        bounds.push_back(entries.size());
+    }
+    const auto by_word = [](const Entry& a, const Entry& b) { return a.word < b.word; };
+    const std::size_t n{runs.size()};
+    for (std::size_t width{1}; width < n; width *= 2)
+        for (std::size_t r{0}; r + width < n; r += 2 * width)
+            std::inplace_merge(entries.begin() + bounds[r], entries.begin() + bounds[r + width],
+                entries.begin() + bounds[std::min(r + 2 * width, n)], by_word);
+    return entries;
+}
+} // namespace
+
+void count_words(std::string_view text, Word_table& table)
+{
+    Counting sink{table, {}};
+    best_split().count(text.data(), text.data() + text.size(), sink, 0);
+}
+
+std::uint32_t index_words(std::string_view text, Line_table& table, std::uint32_t first_line)
+{
+    Indexing sink{table, {}};
+    return best_split().index(text.data(), text.data() + text.size(), sink, first_line);
+}
+
+std::vector<Word_table> count_words_parallel(std::string_view text, int threads)
+{
+    std::uint32_t lines{0};
+    return by_parts<Word_table, std::size_t>(
+        text, threads,
+        [](std::string_view piece, Word_table& table) {
+            count_words(piece, table);
+            return std::uint32_t{0};
+        },
+        [](Word_table& part, const Handed<std::size_t>& h, std::uint32_t) { part.add(h.word, h.hash, h.value); },
+        lines);
+}
+
+std::vector<Line_table> index_words_parallel(std::string_view text, int threads)
+{
+    std::uint32_t next_line{0};
+    return index_words_parallel(text, 1, next_line, threads);
+}
+
+/**
+ * @brief every piece is numbered from first_line, a piece's own lines are what it moves the next ones
+ *        down by, first_line is in the tables of the pieces already
+ */
+std::vector<Line_table> index_words_parallel(std::string_view text, std::uint32_t first_line,
+    std::uint32_t& next_line, int threads)
+{
+    std::uint32_t lines{0};
+    std::vector<Line_table> parts{by_parts<Line_table, Line_table::Seen>(
+        text, threads,
+        [first_line](std::string_view piece, Line_table& table) {
+            return index_words(piece, table, first_line) - first_line;
+        },
+        [](Line_table& part, const Handed<Line_table::Seen>& h, std::uint32_t shift) {
+            part.add(h.word, h.hash, h.value.lines, shift, h.value.count);
+        },
+        lines)};
+    next_line = first_line + lines;
+    return parts;
+}
+
+std::vector<Word_table::Entry> sorted(const std::vector<Word_table>& parts)
+{
+    return sorted_parts(parts);
+}
+
+std::vector<Line_table::Entry> sorted(const std::vector<Line_table>& parts)
+{
+    return sorted_parts(parts);
+}
+
+void display_words(const std::vector<Word_table::Entry>& words)
+{
+    std::cout << std::setw(12) << std::left << "\nWord" << std::setw(7) << std::right << "Count" << std::endl;
+    std::cout << "===================" << std::endl;
+    for (const Word_table::Entry& e : words)
+        std::cout << std::setw(12) << std::left << e.word << std::setw(7) << std::right << e.count << std::endl;
+}
+
+void display_words(const std::vector<Line_table::Entry>& words)
+{
+    std::cout << std::setw(12) << std::left << "\nWord"
+              << "Occurrences" << std::endl;
+    std::cout << "=====================================================================" << std::endl;
+    for (const Line_table::Entry& e : words) {
+        std::cout << std::setw(12) << std::left << e.word << std::left << "[ ";
+        for (const std::uint32_t line : e.lines)
+            std::cout << line << " ";
+        std::cout << "]" << std::endl;
+    }
+}
+
+void part1_mapped(std::string filename)
+{
+    const Mapped_file file{filename};
+    if (!file.is_open()) {
+        std::cerr << "Error opening input file" << std::endl;
+        return;
+    }
+
+    Word_table words;
+    count_words(file.text(), words);
+    display_words(words.sorted());
+}
+
+void part1_parallel(std::string filename, int threads)
+{
+    const Mapped_file file{filename};
+    if (!file.is_open()) {
+        std::cerr << "Error opening input file" << std::endl;
+        return;
+    }
+    const std::vector<Word_table> parts{count_words_parallel(file.text(), threads)};
+    display_words(sorted(parts));
+}
+
+void part2_parallel(std::string filename, int threads)
+{
+    const Mapped_file file{filename};
+    if (!file.is_open()) {
+        std::cerr << "Error opening input file" << std::endl;
+        return;
+    }
+    const std::vector<Line_table> parts{index_words_parallel(file.text(), threads)};
+    display_words(sorted(parts));
+}
+
+} // namespace udemy1::s20c3
@@ -0,0 +1,210 @@
+#ifndef S20C3_COUNT_HPP
+#define S20C3_COUNT_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <set>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace udemy1::s20c3
+{
+
+/**
+ * @class Word_table
+ * @file s20c3_count.hpp
+ * @brief Words and how many times each was seen, the std::map<std::string, int> of part1
+ *        without a node and a string per word
+ *        Open addressing with linear probing over a power of two of slots, each slot keeps
+ *        the hash, the count and where its word is in one arena that holds all the words
+ *        back to back. Sorted once, when the words are wanted in order.
+ */
+class Word_table
+{
+  public:
+    struct Entry {
+        std::string_view word; // into the table, valid until the next add
+        std::size_t count;
+    };
+
+  private:
+    struct Slot {
+        std::uint64_t hash;
+        std::uint64_t offset; // of the word in the arena
+        std::uint64_t length;
+        std::uint64_t count; // 0 for an empty slot
+    };
+
+    std::vector<Slot> slots;
+    std::vector<char> arena;
+    std::size_t used;
+
+    void grow(void);
+
+  public:
+    Word_table();
+
+    // count the word n more times, hash is hash_word(word)
+    void add(std::string_view word, std::uint64_t hash, std::size_t n = 1);
+    std::size_t size(void) const; // distinct words
+    std::size_t memory(void) const; // bytes held by the slots and the arena
+
+    std::vector<Entry> sorted(void) const&; // in the order of std::map<std::string, ...>
+    std::vector<Entry> sorted(void) && = delete; // the entries point into the table
+
+    // fn(word, hash, count) for every word, in no order
+    template <typename Fn>
+    void for_each(Fn fn) const
+    {
+        for (const Slot& s : slots)
+            if (s.count)
+                fn(std::string_view{arena.data() + s.offset, s.length}, s.hash, s.count);
+    }
+};
+
+/**
+ * @class Line_table
+ * @file s20c3_count.hpp
+ * @brief Words and the lines each is on, the std::map<std::string, std::set<int>> of part2
+ *        The slots and the arena of Word_table, a slot points at the lines of its word and
+ *        keeps the count of part1 too. The lines come in going up, a line already there is not
+ *        added again, so a plain vector per word stays sorted without a set.
+ */
+class Line_table
+{
+  public:
+    struct Entry {
+        std::string_view word; // into the table, valid until the next add
+        std::span<const std::uint32_t> lines;
+        std::size_t count; // times it was seen, the count of part1
+    };
+
+    // what for_each hands out of a word
+    struct Seen {
+        std::span<const std::uint32_t> lines;
+        std::size_t count;
+    };
+
+  private:
+    struct Slot {
+        std::uint64_t hash;
+        std::uint64_t offset; // of the word in the arena
+        std::uint32_t length;
+        std::uint32_t word;  // 1 + where its lines are, 0 for an empty slot
+        std::uint32_t last;  // the last of its lines
+        std::uint32_t count; // times it was seen
+    };
+
+    std::vector<Slot> slots;
+    std::vector<char> arena;
+    std::vector<std::vector<std::uint32_t>> lines; // of each word, in the order they came
+    std::size_t postings;
+
+    Slot& find(std::string_view word, std::uint64_t hash);
+    void grow(void);
+
+  public:
+    Line_table();
+
+    // the word is on line, line is not before any line added so far
+    void add(std::string_view word, std::uint64_t hash, std::uint32_t line)
+    {
+        Slot& s{find(word, hash)};
+        ++s.count;
+        if (s.last != line || lines[s.word - 1].empty()) {
+            lines[s.word - 1].push_back(line);
+            s.last = line;
+            ++postings;
+        }
+    }
+    // the word is on each of more moved down by shift, all after the lines added so far, and was seen count times
+    void add(std::string_view word, std::uint64_t hash, std::span<const std::uint32_t> more, std::uint32_t shift,
+        std::size_t count);
+
+    std::size_t size(void) const; // distinct words
+    std::size_t size_postings(void) const; // (word, line) pairs
+    std::size_t memory(void) const; // bytes held by the slots, the arena and the lines
+
+    std::vector<Entry> sorted(void) const&; // in the order of std::map<std::string, ...>
+    std::vector<Entry> sorted(void) && = delete; // the entries point into the table
+
+    // fn(word, hash, seen) for every word, in no order
+    template <typename Fn>
+    void for_each(Fn fn) const
+    {
+        for (const Slot& s : slots)
+            if (s.word)
+                fn(std::string_view{arena.data() + s.offset, s.length}, s.hash,
+                    Seen{std::span<const std::uint32_t>{lines[s.word - 1]}, s.count});
+    }
+};
+
+std::uint64_t hash_word(std::string_view word);
+
+/**
+ * @brief Add the words of text to table the way part1 counts them: split on the whitespace
+ *        of the "C" locale as in >> and cleaned of . , ; : as by clean_string, a word of
+ *        only those is counted as the empty word. A word with none of them, or with them only
+ *        at its end, is hashed where it lies in text, the others are cleaned into one reused
+ *        buffer. With AVX2 the text is split 64 bytes at a time on bit masks.
+ */
+void count_words(std::string_view text, Word_table& table);
+
+/**
+ * @brief Add the words of text to table with the line each is on, the way part2 reads them
+ *        with std::getline: the first line of text is first_line and each '\n' starts the
+ *        next one. The words are split and cleaned as by count_words.
+ * @return the line after the last '\n' of text
+ */
+std::uint32_t index_words(std::string_view text, Line_table& table, std::uint32_t first_line = 1);
+
+/**
+ * @brief count_words and index_words over several threads (0 uses the OpenMP default)
+ *        The text is cut at line starts into one piece per thread and each piece goes into
+ *        a table of its own. The words of those tables are then handed out by hash to as
+ *        many parts as there are threads, and each thread merges one part from every table,
+ *        so no part has a word of another and the merge is no less parallel than the count.
+ *        The lines of each piece are moved down by the lines of the pieces before it.
+ * @return the parts, sorted() puts their words back in one order
+ */
+std::vector<Word_table> count_words_parallel(std::string_view text, int threads = 0);
+std::vector<Line_table> index_words_parallel(std::string_view text, int threads = 0);
+
+/**
+ * @brief index_words_parallel of text with its first line first_line, as index_words numbers them
+ * @param next_line set to the line after the last '\n' of text
+ */
+std::vector<Line_table> index_words_parallel(std::string_view text, std::uint32_t first_line,
+    std::uint32_t& next_line, int threads = 0);
+
+// the words of all the parts, each sorted on its own thread then merged
+// the entries point into the parts, so the parts must outlive them and cannot be temporaries
+std::vector<Word_table::Entry> sorted(const std::vector<Word_table>& parts);
+std::vector<Line_table::Entry> sorted(const std::vector<Line_table>& parts);
+std::vector<Word_table::Entry> sorted(std::vector<Word_table>&& parts) = delete;
+std::vector<Line_table::Entry> sorted(std::vector<Line_table>&& parts) = delete;
+
+// the displays of part1 and part2, the same output as display_words for the maps
+void display_words(const std::vector<Word_table::Entry>& words);
+void display_words(const std::vector<Line_table::Entry>& words);
+
+// the original: the map display, clean_string and the two parts reading the file with >>
+void display_words(const std::map<std::string, int>& words);
+void display_words(const std::map<std::string, std::set<int>>& words);
+std::string clean_string(const std::string& s);
+void part1(std::string filename);
+void part2(std::string filename);
+
+// the same output as part1, the file is mapped and counted into a Word_table
+void part1_mapped(std::string filename);
+
+// the same output as part1 and part2, the file is mapped and split over threads
+void part1_parallel(std::string filename, int threads = 0);
+void part2_parallel(std::string filename, int threads = 0);
+
+} // namespace udemy1::s20c3
+
+#endif // S20C3_COUNT_HPP
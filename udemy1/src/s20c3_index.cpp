@@ -0,0 +1,464 @@
+#include "s20c3_index.hpp"
+
+#include "mapped_file.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+namespace udemy1::s20c3
+{
+
+namespace
+{
+// what an index file starts with, the blocks follow in the order of the counts
+struct File_header {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t term_size; // sizeof(Line_index::Term), the file is of the same build
+    std::uint64_t terms;
+    std::uint64_t words;    // bytes
+    std::uint64_t postings; // bytes
+    std::uint64_t lines;
+    std::uint64_t text_bytes; // the Text_end of the index
+    std::uint64_t line_start;
+    std::uint32_t line;
+    std::uint32_t unused;
+};
+
+constexpr char index_magic[8]{'s', '2', '0', 'c', '3', 'i', 'x', '\0'};
+constexpr std::uint32_t index_version{2}; // 2 has the counts and the Text_end
+
+void write_gap(std::vector<std::uint8_t>& out, std::uint32_t gap)
+{
+    for (; gap >= 0x80; gap >>= 7)
+        out.push_back(static_cast<std::uint8_t>(gap | 0x80));
+    out.push_back(static_cast<std::uint8_t>(gap));
+}
+} // namespace
+
+Line_index::Lines::iterator::iterator()
+    : next{nullptr}
+    , left{0}
+    , line{0}
+{
+}
+
+Line_index::Lines::iterator::iterator(const std::uint8_t* bytes, std::uint32_t count)
+    : next{bytes}
+    , left{count}
+    , line{count ? read_gap(next) : 0}
+{
+}
+
+Line_index::Lines::Lines()
+    : bytes{nullptr}
+    , count{0}
+{
+}
+
+Line_index::Lines::Lines(const std::uint8_t* bytes, std::uint32_t count)
+    : bytes{bytes}
+    , count{count}
+{
+}
+
+Line_index::Lines::iterator Line_index::Lines::begin() const
+{
+    return iterator{bytes, count};
+}
+
+Line_index::Lines::iterator Line_index::Lines::end() const
+{
+    return iterator{};
+}
+
+std::uint32_t Line_index::Lines::size(void) const
+{
+    return count;
+}
+
+bool Line_index::Lines::empty(void) const
+{
+    return count == 0;
+}
+
+Line_index::Line_index()
+    : lines{0}
+    , end{0, 0, 1}
+    , opened{true}
+{
+}
+
+Line_index::Line_index(const std::vector<Line_table>& parts, Text_end end)
+    : lines{0}
+    , end{end}
+    , opened{true}
+{
+    const std::vector<Line_table::Entry> entries{sorted(parts)};
+    std::size_t bytes{0};
+    for (const Line_table::Entry& e : entries)
+        bytes += e.word.size();
+    for (const Line_table& part : parts)
+        lines += part.size_postings();
+    own_terms.reserve(entries.size());
+    own_words.reserve(bytes);
+    own_postings.reserve(lines + lines / 4); // mostly a byte a line
+
+    for (const Line_table::Entry& e : entries) {
+        own_terms.push_back(Term{own_words.size(), own_postings.size(), e.count,
+            static_cast<std::uint32_t>(e.word.size()), static_cast<std::uint32_t>(e.lines.size()), e.lines.back(), 0});
+        own_words.insert(own_words.end(), e.word.begin(), e.word.end());
+        std::uint32_t previous{0};
+        for (const std::uint32_t line : e.lines) {
+            write_gap(own_postings, line - previous);
+            previous = line;
+        }
+    }
+    own_postings.shrink_to_fit();
+
+    terms = own_terms;
+    words = std::string_view{own_words.data(), own_words.size()};
+    postings = own_postings;
+}
+
+/**
+ * @brief map the file, a header that does not add up to the size of the file is not an index
+ */
+Line_index::Line_index(const std::string& index_file, Mapped_file::Access access)
+    : file{std::make_unique<Mapped_file>(index_file, access)}
+    , lines{0}
+    , end{0, 0, 1}
+    , opened{false}
+{
+    const std::string_view bytes{file->text()};
+    File_header h;
+    if (!file->is_open() || bytes.size() < sizeof h)
+        return;
+    std::memcpy(&h, bytes.data(), sizeof h);
+    if (std::memcmp(h.magic, index_magic, sizeof index_magic) != 0 || h.version != index_version ||
+        h.term_size != sizeof(Term) || h.terms > (bytes.size() - sizeof h) / sizeof(Term) ||
+        sizeof h + h.terms * sizeof(Term) + h.words + h.postings != bytes.size())
+        return;
+
+    if (h.line_start > h.text_bytes)
+        return;
+
+    const char* at{bytes.data() + sizeof h};
+    const std::span<const Term> read_terms{reinterpret_cast<const Term*>(at), h.terms};
+    at += h.terms * sizeof(Term);
+    const std::string_view read_words{at, h.words};
+    at += h.words;
+    const std::span<const std::uint8_t> read_postings{reinterpret_cast<const std::uint8_t*>(at), h.postings};
+
+    // the terms are checked here, read ahead in one go as they lie together; of the postings only
+    // the last byte is read, no gap goes on past it
+    file->will_need({reinterpret_cast<const char*>(read_terms.data()), read_terms.size_bytes()});
+    std::uint64_t term_lines{0};
+    for (std::size_t i{0}; i < read_terms.size(); ++i) {
+        const Term& t{read_terms[i]};
+        const std::uint64_t next{i + 1 == read_terms.size() ? h.postings : read_terms[i + 1].postings};
+        if (t.word > h.words || t.length > h.words - t.word || t.postings > next || next > h.postings ||
+            t.lines == 0 || t.lines > next - t.postings || t.last == 0) // a line takes a byte at least
+            return;
+        term_lines += t.lines;
+    }
+    if (term_lines != h.lines || (!read_postings.empty() && read_postings.back() & 0x80))
+        return;
+
+    terms = read_terms;
+    words = read_words;
+    postings = read_postings;
+    lines = h.lines;
+    end = Text_end{h.text_bytes, h.line_start, h.line};
+    opened = true;
+}
+
+bool Line_index::is_open(void) const
+{
+    return opened;
+}
+
+/**
+ * @brief written next to index_file and renamed over it, a reader never maps half an index
+ */
+bool Line_index::save(const std::string& index_file) const
+{
+    File_header h{{}, index_version, sizeof(Term), terms.size(), words.size(), postings.size(), lines, end.bytes,
+        end.line_start, end.line, 0};
+    std::memcpy(h.magic, index_magic, sizeof index_magic);
+
+    const std::string part{index_file + ".part"};
+    {
+        std::ofstream ofs{part, std::ios::binary | std::ios::trunc};
+        ofs.write(reinterpret_cast<const char*>(&h), sizeof h);
+        ofs.write(reinterpret_cast<const char*>(terms.data()), static_cast<std::streamsize>(terms.size_bytes()));
+        ofs.write(words.data(), static_cast<std::streamsize>(words.size()));
+        ofs.write(reinterpret_cast<const char*>(postings.data()), static_cast<std::streamsize>(postings.size()));
+        if (!ofs.flush())
+            return false;
+    }
+    std::error_code ec;
+    std::filesystem::rename(part, index_file, ec);
+    return !ec;
+}
+
+std::size_t Line_index::size(void) const
+{
+    return terms.size();
+}
+
+std::size_t Line_index::size_postings(void) const
+{
+    return lines;
+}
+
+Line_index::Text_end Line_index::text_end(void) const
+{
+    return end;
+}
+
+std::size_t Line_index::memory(void) const
+{
+    if (file)
+        return terms.size_bytes() + words.size() + postings.size();
+    return own_terms.capacity() * sizeof(Term) + own_words.capacity() + own_postings.capacity();
+}
+
+Line_index::Lines Line_index::lines_of(const Term& t) const
+{
+    const std::size_t stop{&t + 1 == terms.data() + terms.size() ? postings.size() : (&t + 1)->postings};
+    if (postings[stop - 1] & 0x80)
+        return Lines{};
+    // a gap takes 5 bytes at most and none goes on past the last byte of the postings: a term with
+    // room for 5 bytes a line is walked in them whatever its count, one nearer the end is counted
+    std::uint32_t count{t.lines};
+    if (std::uint64_t{5} * t.lines > postings.size() - t.postings) {
+        const std::uint8_t* p{postings.data() + t.postings};
+        for (count = 0; count < t.lines && p < postings.data() + postings.size(); ++count)
+            read_gap(p);
+    }
+    return Lines{postings.data() + t.postings, count};
+}
+
+Line_index::Entry Line_index::operator[](std::size_t i) const
+{
+    const Term& t{terms[i]};
+    return Entry{words.substr(t.word, t.length), lines_of(t), t.count};
+}
+
+Line_index::Lines Line_index::lookup(std::string_view word) const
+{
+    const auto it{std::lower_bound(terms.begin(), terms.end(), word,
+        [&](const Term& t, std::string_view w) { return words.substr(t.word, t.length) < w; })};
+    if (it == terms.end() || words.substr(it->word, it->length) != word)
+        return Lines{};
+    if (file) { // the lines are read in one go rather than a page fault at a time
+        const std::size_t last{it + 1 == terms.end() ? postings.size() : (it + 1)->postings};
+        file->will_need({reinterpret_cast<const char*>(postings.data()) + it->postings, last - it->postings});
+    }
+    return lines_of(*it);
+}
+
+Line_index Line_index::appended(std::string_view text, int threads) const
+{
+    if (!opened || text.size() < end.bytes)
+        return build_index(text, threads);
+
+    // the words of the last line as far as it went, and those of the text from its start on
+    Line_table taken_table;
+    index_words(text.substr(end.line_start, end.bytes - end.line_start), taken_table, end.line);
+    const std::vector<Line_table::Entry> taken{taken_table.sorted()};
+    const std::string_view rest{text.substr(end.line_start)};
+    std::uint32_t next_line{0};
+    const std::vector<Line_table> parts{index_words_parallel(rest, end.line, next_line, threads)};
+    const std::vector<Line_table::Entry> added{sorted(parts)};
+
+    const std::size_t newline{rest.rfind('\n')};
+    Line_index index;
+    index.end = Text_end{text.size(), newline == std::string_view::npos ? end.line_start : end.line_start + newline + 1,
+        next_line};
+    std::size_t more_words{0};
+    for (const Line_table::Entry& e : added)
+        more_words += e.word.size();
+    for (const Line_table& part : parts)
+        index.lines += part.size_postings();
+    index.own_terms.reserve(terms.size() + added.size());
+    index.own_words.reserve(words.size() + more_words);
+    index.own_postings.reserve(postings.size() + index.lines * 5); // a gap takes 5 bytes at most, never grown
+
+    std::size_t t{0}, a{0}, k{0};
+    while (t < terms.size() || a < added.size()) {
+        const std::string_view old_word{t < terms.size() ? words.substr(terms[t].word, terms[t].length) : ""};
+        const bool old{t < terms.size() && (a == added.size() || old_word <= added[a].word)};
+        const bool now{a < added.size() && (t == terms.size() || added[a].word <= old_word)};
+        const std::string_view word{old ? old_word : added[a].word};
+
+        std::span<const std::uint8_t> bytes;
+        Term term{0, 0, 0, static_cast<std::uint32_t>(word.size()), 0, 0, 0};
+        if (old) {
+            const Term& o{terms[t++]};
+            const std::size_t stop{t == terms.size() ? postings.size() : terms[t].postings};
+            bytes = postings.subspan(o.postings, stop - o.postings);
+            term.count = o.count;
+            term.lines = o.lines;
+            term.last = o.last;
+            while (k < taken.size() && taken[k].word < word)
+                ++k;
+            // no opened file has a term without bytes, but a term with none would wrap from below
+            if (k < taken.size() && taken[k].word == word && !bytes.empty()) {
+                // it was on the last line, read again with the rest: its last gap comes off
+                std::size_t from{bytes.size() - 1};
+                while (from > 0 && bytes[from - 1] & 0x80)
+                    --from;
+                const std::uint8_t* gap{bytes.data() + from};
+                term.last -= read_gap(gap);
+                term.count -= taken[k].count;
+                --term.lines;
+                bytes = bytes.first(from);
+                index.lines -= 1;
+            }
+        }
+        std::span<const std::uint32_t> more;
+        if (now) {
+            more = added[a].lines;
+            term.count += added[a].count;
+            ++a;
+        }
+        if (term.lines == 0 && more.empty())
+            continue; // only on the last line, and no more once it is read to its end
+
+        term.word = index.own_words.size();
+        term.postings = index.own_postings.size();
+        term.lines += static_cast<std::uint32_t>(more.size());
+        index.own_words.insert(index.own_words.end(), word.begin(), word.end());
+        index.own_postings.insert(index.own_postings.end(), bytes.begin(), bytes.end());
+        for (const std::uint32_t line : more) {
+            write_gap(index.own_postings, line - term.last);
+            term.last = line;
+        }
+        index.own_terms.push_back(term);
+    }
+    index.lines += lines;
+
+    index.terms = index.own_terms;
+    index.words = std::string_view{index.own_words.data(), index.own_words.size()};
+    index.postings = index.own_postings;
+    return index;
+}
+
+Line_index build_index(std::string_view text, int threads)
+{
+    std::uint32_t next_line{0};
+    std::vector<Line_table> parts{index_words_parallel(text, 1, next_line, threads)};
+    const std::size_t newline{text.rfind('\n')};
+    return Line_index{parts, {text.size(), newline == std::string_view::npos ? 0 : newline + 1, next_line}};
+}
+
+bool update_index(const std::string& text_file, const std::string& index_file, int threads)
+{
+    const Mapped_file file{text_file};
+    if (!file.is_open())
+        return false;
+    const Line_index saved{index_file, Mapped_file::Access::sequential};
+    return (saved.is_open() ? saved.appended(file.text(), threads) : build_index(file.text(), threads))
+        .save(index_file);
+}
+
+std::vector<std::uint32_t> find_lines(const Line_index& index, std::string_view query)
+{
+    // the words of each side of an OR
+    std::vector<std::vector<std::string_view>> either(1);
+    for (std::size_t at{0};;) {
+        at = query.find_first_not_of(" \t\n\v\f\r", at);
+        if (at == std::string_view::npos)
+            break;
+        const std::size_t end{std::min(query.find_first_of(" \t\n\v\f\r", at), query.size())};
+        const std::string_view word{query.substr(at, end - at)};
+        if (word == "OR")
+            either.emplace_back();
+        else
+            either.back().push_back(word);
+        at = end;
+    }
+
+    std::vector<std::uint32_t> found, all, both;
+    for (const std::vector<std::string_view>& words : either) {
+        if (words.empty())
+            continue;
+        // the fewest lines first, the others only take lines away from them
+        std::vector<Line_index::Lines> lists;
+        for (const std::string_view w : words)
+            lists.push_back(index.lookup(w));
+        std::sort(lists.begin(), lists.end(),
+            [](const Line_index::Lines& a, const Line_index::Lines& b) { return a.size() < b.size(); });
+        all.assign(lists.front().begin(), lists.front().end());
+        for (std::size_t l{1}; l < lists.size() && !all.empty(); ++l) {
+            both.clear();
+            std::set_intersection(all.begin(), all.end(), lists[l].begin(), lists[l].end(), std::back_inserter(both));
+            all.swap(both);
+        }
+
+        both.clear();
+        std::set_union(found.begin(), found.end(), all.begin(), all.end(), std::back_inserter(both));
+        found.swap(both);
+    }
+    return found;
+}
+
+void display_words(const Line_index& index)
+{
+    std::cout << std::setw(12) << std::left << "\nWord"
+              << "Occurrences" << std::endl;
+    std::cout << "=====================================================================" << std::endl;
+    for (std::size_t i{0}; i < index.size(); ++i) {
+        const Line_index::Entry e{index[i]};
+        std::cout << std::setw(12) << std::left << e.word << std::left << "[ ";
+        for (const std::uint32_t line : e.lines)
+            std::cout << line << " ";
+        std::cout << "]" << std::endl;
+    }
+}
+
+void display_counts(const Line_index& index)
+{
+    std::cout << std::setw(12) << std::left << "\nWord" << std::setw(7) << std::right << "Count" << std::endl;
+    std::cout << "===================" << std::endl;
+    for (std::size_t i{0}; i < index.size(); ++i) {
+        const Line_index::Entry e{index[i]};
+        std::cout << std::setw(12) << std::left << e.word << std::setw(7) << std::right << e.count << std::endl;
+    }
+}
+
+void part2_indexed(std::string filename, int threads)
+{
+    const Mapped_file file{filename};
+    if (!file.is_open()) {
+        std::cerr << "Error opening input file" << std::endl;
+        return;
+    }
+    display_words(build_index(file.text(), threads));
+}
+
+void part1_incremental(std::string filename, std::string index_file, int threads)
+{
+    if (!update_index(filename, index_file, threads)) {
+        std::cerr << "Error indexing input file" << std::endl;
+        return;
+    }
+    display_counts(Line_index{index_file});
+}
+
+void part2_incremental(std::string filename, std::string index_file, int threads)
+{
+    if (!update_index(filename, index_file, threads)) {
+        std::cerr << "Error indexing input file" << std::endl;
+        return;
+    }
+    display_words(Line_index{index_file});
+}
+
+} // namespace udemy1::s20c3
@@ -0,0 +1,207 @@
+#ifndef S20C3_INDEX_HPP
+#define S20C3_INDEX_HPP
+
+#include "mapped_file.hpp"
+#include "s20c3_count.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace udemy1::s20c3
+{
+
+/**
+ * @class Line_index
+ * @file s20c3_index.hpp
+ * @brief The words of part2 and the lines each is on, read only and packed
+ *        A sorted dictionary of terms, each with where its word is in one block of all the words
+ *        and where its lines are in one block of all the postings. The lines of a word are kept
+ *        as the gaps between them, each a varint of 7 bits a byte, a line next to the one before
+ *        takes a byte. Looked up by binary search, the lines are decoded as they are walked.
+ *        save() writes the three blocks after a header to one file, an index opened from that
+ *        file maps it and reads the blocks where they are, only the terms are read, to check them,
+ *        the words and the lines are not read until looked up. No walk of the lines leaves the
+ *        postings, whatever the file holds.
+ *        The index knows how far into its text it is, appended() reads only the text after that
+ *        and gives the index a full build of the longer text would.
+ */
+class Line_index
+{
+  public:
+    // the lines of one word, in order
+    class Lines
+    {
+        const std::uint8_t* bytes; // the varint gaps
+        std::uint32_t count;
+
+      public:
+        class iterator
+        {
+            const std::uint8_t* next; // the gap to the line after this one
+            std::uint32_t left;       // lines from this one on, 0 at the end
+            std::uint32_t line;
+
+          public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = std::uint32_t;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const std::uint32_t*;
+            using reference = std::uint32_t;
+
+            iterator();
+            iterator(const std::uint8_t* bytes, std::uint32_t count);
+
+            std::uint32_t operator*() const
+            {
+                return line;
+            }
+            iterator& operator++()
+            {
+                if (--left)
+                    line += read_gap(next);
+                return *this;
+            }
+            iterator operator++(int)
+            {
+                iterator was{*this};
+                ++*this;
+                return was;
+            }
+            bool operator==(const iterator& other) const
+            {
+                return left == other.left;
+            }
+        };
+
+        Lines();
+        Lines(const std::uint8_t* bytes, std::uint32_t count);
+
+        iterator begin() const;
+        iterator end() const;
+        std::uint32_t size(void) const;
+        bool empty(void) const;
+    };
+
+    struct Entry {
+        std::string_view word; // into the index
+        Lines lines;
+        std::size_t count; // times it was seen, the count of part1
+    };
+
+    // a word of the dictionary
+    struct Term {
+        std::uint64_t word;     // where it is in the words
+        std::uint64_t postings; // where its lines are in the postings
+        std::uint64_t count;
+        std::uint32_t length;
+        std::uint32_t lines;  // how many
+        std::uint32_t last;   // the last of them, the gap of a line added after is from it
+        std::uint32_t unused; // 0, no byte of a saved index is left to chance
+    };
+
+    // how far into its text an index is
+    struct Text_end {
+        std::uint64_t bytes;      // of the text indexed
+        std::uint64_t line_start; // of its last line, the one without a '\n' yet if it has not ended
+        std::uint32_t line;       // the number of that line
+    };
+
+  private:
+    // the blocks, built here or mapped from an index file
+    std::vector<Term> own_terms;
+    std::vector<char> own_words;
+    std::vector<std::uint8_t> own_postings;
+    std::unique_ptr<Mapped_file> file;
+
+    std::span<const Term> terms; // in the order of the words
+    std::string_view words;
+    std::span<const std::uint8_t> postings;
+    std::size_t lines; // (word, line) pairs
+    Text_end end;
+    bool opened;
+
+    Lines lines_of(const Term& t) const; // none for a term whose last gap runs on past its bytes
+
+  public:
+    Line_index();
+    // the words of the parts from index_words_parallel, or one Line_table, put in order and packed,
+    // end is how far into the text they are
+    explicit Line_index(const std::vector<Line_table>& parts, Text_end end = {0, 0, 1});
+    // the index saved to index_file, not open if there is none, it is not one or a term of it is out of
+    // its blocks; random access for lookups, sequential for an index read in full as appended() does
+    explicit Line_index(const std::string& index_file, Mapped_file::Access access = Mapped_file::Access::random);
+    Line_index(Line_index&&) = default;
+    Line_index& operator=(Line_index&&) = default;
+
+    bool is_open(void) const;
+    bool save(const std::string& index_file) const; // false if it could not be written
+
+    std::size_t size(void) const;          // words
+    std::size_t size_postings(void) const; // (word, line) pairs
+    std::size_t memory(void) const;        // bytes held by the terms, the words and the postings
+    Text_end text_end(void) const;
+
+    Entry operator[](std::size_t i) const; // the i-th word in order
+    Lines lookup(std::string_view word) const; // none if the word is not there
+
+    /**
+     * @brief The index of text, the text of this index with more appended. Only the text from the
+     *        start of the last line on is read: the words of that line so far are taken off the
+     *        terms that end on it and the rest of the text is indexed from that line on, then the
+     *        terms and the new words are merged in order. The postings of a term are copied as
+     *        they are, the new lines go on after its last. A text shorter than the one indexed is
+     *        not an append and is indexed in full; a change to the text already indexed is not seen.
+     */
+    Line_index appended(std::string_view text, int threads = 0) const;
+
+    // a gap of 32 bits takes 5 bytes at most, a longer one in a damaged file is cut there
+    static std::uint32_t read_gap(const std::uint8_t*& p)
+    {
+        std::uint32_t gap{*p & 0x7fu};
+        for (int shift{7}; (*p++ & 0x80) && shift < 35; shift += 7)
+            gap |= static_cast<std::uint32_t>(*p & 0x7f) << shift;
+        return gap;
+    }
+};
+
+/**
+ * @brief The Line_index of text in one pass over it, on several threads (0 uses the OpenMP default):
+ *        index_words_parallel and the tables packed as they come out sorted
+ */
+Line_index build_index(std::string_view text, int threads = 0);
+
+/**
+ * @brief Bring the index saved to index_file up to the text of text_file: appended() to the index
+ *        there, or build_index when there is none or it is not one
+ * @return false if the text could not be read or the index not written
+ */
+bool update_index(const std::string& text_file, const std::string& index_file, int threads = 0);
+
+/**
+ * @brief The lines with the words of query, in order. Words one after the other must all be on
+ *        a line, OR between them is either: "a b OR c" is the lines with both a and b, or with c.
+ *        The words are looked up as they are, cleaned words as part2 keeps them.
+ */
+std::vector<std::uint32_t> find_lines(const Line_index& index, std::string_view query);
+
+// the display of part2, the same output as display_words for the map
+void display_words(const Line_index& index);
+// the display of part1 out of the counts of the index
+void display_counts(const Line_index& index);
+
+// the same output as part2, the file is mapped and indexed into a Line_index
+void part2_indexed(std::string filename, int threads = 0);
+
+// the same output as part1 and part2, from the index in index_file brought up to the file by update_index
+void part1_incremental(std::string filename, std::string index_file, int threads = 0);
+void part2_incremental(std::string filename, std::string index_file, int threads = 0);
+
+} // namespace udemy1::s20c3
+
+#endif // S20C3_INDEX_HPP
@@ -1,9 +1,42 @@
 //#include "udemy1-testing.hpp"
+#include "account_pool.hpp"
+#include "atom_table.hpp"
+#include "money.hpp"
+#include "movie_table.hpp"
+#include "movies.hpp"
+#include "movies_file.hpp"
+#include "mystring.hpp"
+#include "mystring_simd.hpp"
+#include "print_sink.hpp"
+#include "s15c_journal.hpp"
+#include "s15c_ledger.hpp"
+#include "s16c_class.hpp"
+#include "s19c3_keywords.hpp"
+#include "s19c3_search.hpp"
+#include "s20c3_count.hpp"
+#include "s20c3_index.hpp"
 #include "udemy1.hpp"
 
+#include <algorithm>
+#include <csignal>
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
 #include <gtest/gtest.h>
 #include <iostream>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <omp.h>
+#include <random>
+#include <set>
 #include <sstream>
+#include <string_view>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <unordered_map>
+#include <vector>
 
 TEST(udemy_s4c, valid_values)
 {
@@ -128,6 +161,1087 @@ TEST(udemy_s8c, valid_values)
     EXPECT_EQ(ss_out.str(), result);
 }
 
+namespace
+{
+// the movies as the section 13 challenge first kept them, a vector searched front to back
+class Scanned_movies
+{
+    std::vector<udemy1::s13c::Movie> movies;
+
+  public:
+    bool add_movie(const std::string& name, const std::string& rating, int watched)
+    {
+        for (const udemy1::s13c::Movie& movie : movies)
+            if (movie.getName() == name)
+                return false;
+        movies.emplace_back(name, rating, watched);
+        return true;
+    }
+
+    bool increment_watched(const std::string& name)
+    {
+        for (udemy1::s13c::Movie& movie : movies)
+            if (movie.getName() == name) {
+                movie.increment_watched();
+                return true;
+            }
+        return false;
+    }
+
+    bool get_watched(const std::string& name, int& watched) const
+    {
+        for (const udemy1::s13c::Movie& movie : movies)
+            if (movie.getName() == name) {
+                watched = movie.getWatched();
+                return true;
+            }
+        return false;
+    }
+
+    const std::vector<udemy1::s13c::Movie>& all(void) const
+    {
+        return movies;
+    }
+
+    void display(void) const
+    {
+        if (movies.empty())
+            std::cout << "Sorry, no movies to display" << std::endl << std::endl;
+        else {
+            std::cout << std::endl << "===================================" << std::endl;
+            for (const udemy1::s13c::Movie& movie : movies)
+                movie.display();
+            std::cout << "===================================" << std::endl << std::endl;
+        }
+    }
+};
+
+// what display() prints, the catalogs are compared through it
+template <typename Catalog>
+std::string listing(const Catalog& movies)
+{
+    std::ostringstream out;
+    std::streambuf* const saved{std::cout.rdbuf(out.rdbuf())};
+    movies.display();
+    std::cout.rdbuf(saved);
+    return out.str();
+}
+
+// titles that only just differ, each picked many times over, and a few never added
+std::string movie_title(std::mt19937& rng)
+{
+    static const char* const titles[]{"Big", "big", "Big ", " Big", "Bi", "", "Star Wars", "Star Wars II",
+        "The Good, the Bad and the Ugly", "Cinema Paradiso", "Unreleased", "Unreleased, the sequel"};
+    const std::string title{titles[rng() % std::size(titles)]};
+    return rng() % 3 ? title : title + " #" + std::to_string(rng() % 200);
+}
+
+const char* const movie_ratings[]{"G", "PG", "PG-13", "R"};
+} // namespace
+
+// the name index adds and increments the movies a scan of the vector does, repeated and unknown titles too
+TEST(udemy_s13c_movies, same_as_scan)
+{
+    udemy1::s13c::Movies movies;
+    Scanned_movies expected;
+    EXPECT_EQ(listing(movies), listing(expected));
+    EXPECT_FALSE(movies.increment_watched("Big"));
+    EXPECT_TRUE(movies.add_movie("Big", "PG-13", 2) && expected.add_movie("Big", "PG-13", 2));
+    EXPECT_FALSE(movies.add_movie("Big", "R", 0));
+
+    std::mt19937 rng{13};
+    for (int i{0}; i < 4000; ++i) {
+        const std::string title{movie_title(rng)};
+        if (title.starts_with("Unreleased") || rng() % 2) {
+            EXPECT_EQ(movies.increment_watched(title), expected.increment_watched(title)) << title;
+        } else {
+            const std::string rating{movie_ratings[rng() % 4]};
+            const int watched{static_cast<int>(rng() % 10)};
+            EXPECT_EQ(movies.add_movie(title, rating, watched), expected.add_movie(title, rating, watched)) << title;
+        }
+    }
+    EXPECT_FALSE(movies.increment_watched("Unreleased"));
+    EXPECT_EQ(listing(movies), listing(expected));
+}
+
+// a batch of add_watched ends where an increment_watched per watch does, on any threads,
+// smaller and larger than the catalog, and a count past the range of an int stops at its end
+TEST(udemy_s13c_movies, add_watched_same_as_increment)
+{
+    using udemy1::s13c::Watch_event;
+    std::vector<std::string> names;
+    for (int i{0}; i < 2000; ++i)
+        names.push_back("Feature #" + std::to_string(i));
+    for (int i{0}; i < 100; ++i)
+        names.push_back("Unreleased #" + std::to_string(i));
+
+    std::mt19937 rng{7};
+    for (const std::size_t batch : {std::size_t{500}, std::size_t{20'000}})
+        for (const int threads : {1, 4}) {
+            udemy1::s13c::Movies movies;
+            Scanned_movies expected;
+            for (int i{0}; i < 2000; ++i) {
+                movies.add_movie(names[i], movie_ratings[i % 4], i % 3);
+                expected.add_movie(names[i], movie_ratings[i % 4], i % 3);
+            }
+
+            std::vector<Watch_event> events;
+            std::size_t known{0};
+            for (std::size_t i{0}; i < batch; ++i) {
+                const std::string& name{names[rng() % names.size()]};
+                const int count{static_cast<int>(rng() % 5) + 1};
+                events.push_back({name, count});
+                for (int k{0}; k < count; ++k)
+                    if (!expected.increment_watched(name))
+                        break;
+                known += name.starts_with("Feature");
+            }
+            EXPECT_EQ(movies.add_watched(events, threads), known) << batch << " events, " << threads << " threads";
+            EXPECT_EQ(listing(movies), listing(expected)) << batch << " events, " << threads << " threads";
+        }
+
+    // with more movies than events too, the batch is then summed by position
+    for (const int more : {0, 20}) {
+        udemy1::s13c::Movies movies;
+        Scanned_movies expected;
+        movies.add_movie("Big", "PG-13", std::numeric_limits<int>::max() - 10);
+        movies.add_movie("Small", "G", std::numeric_limits<int>::min() + 10);
+        movies.add_movie("Medium", "R", 5);
+        expected.add_movie("Big", "PG-13", std::numeric_limits<int>::max());
+        expected.add_movie("Small", "G", std::numeric_limits<int>::min());
+        expected.add_movie("Medium", "R", 6);
+        for (int i{0}; i < more; ++i) {
+            movies.add_movie(names[i], "G", 0);
+            expected.add_movie(names[i], "G", 0);
+        }
+        const std::vector<Watch_event> events{{"Big", 6}, {"Small", -6}, {"Medium", 1}, {"Big", 6}, {"Small", -6},
+            {"Big", std::numeric_limits<int>::max()}, {"Unreleased", 1}};
+        EXPECT_EQ(movies.add_watched(events), 6u);
+        EXPECT_EQ(listing(movies), listing(expected)) << more;
+    }
+}
+
+// a saved catalog lists, finds and increments the movies a scan of the vector does, and keeps the
+// increments once closed; a CSV turned into one keeps the first of a repeated title
+TEST(udemy_s13c_movies_file, same_as_scan)
+{
+    using udemy1::s13c::Movies_file;
+    const std::string path{(std::filesystem::temp_directory_path() / "udemy1_movies_file").string()};
+    std::filesystem::remove(path);
+
+    udemy1::s13c::Movies movies;
+    Scanned_movies expected;
+    std::mt19937 rng{8};
+    for (int i{0}; i < 1000; ++i) {
+        const std::string title{movie_title(rng)};
+        if (!title.starts_with("Unreleased")) {
+            movies.add_movie(title, movie_ratings[i % 4], i);
+            expected.add_movie(title, movie_ratings[i % 4], i);
+        }
+    }
+    ASSERT_TRUE(movies.save(path));
+    {
+        Movies_file file{path};
+        ASSERT_TRUE(file.is_open());
+        EXPECT_EQ(listing(file), listing(expected));
+        for (int i{0}; i < 3000; ++i) {
+            const std::string title{movie_title(rng)};
+            int got{-1}, watched{-1};
+            EXPECT_EQ(file.get_watched(title, got), expected.get_watched(title, watched)) << title;
+            EXPECT_EQ(got, watched) << title;
+            EXPECT_EQ(file.increment_watched(title), expected.increment_watched(title)) << title;
+        }
+        EXPECT_FALSE(file.increment_watched("Unreleased"));
+    }
+    Movies_file file{path};
+    ASSERT_TRUE(file.is_open());
+    EXPECT_EQ(listing(file), listing(expected));
+
+    const std::string csv{path + ".csv"};
+    {
+        std::ofstream out{csv};
+        out << "name,rating,watched\n"
+            << "Big,PG-13,2\r\n"
+            << "\"The Good, the Bad and the Ugly\",R,7\n"
+            << "\n"
+            << "\"Say \"\"Cheese\"\"\",G,0\n"
+            << "Big,R,9\n";
+    }
+    ASSERT_TRUE(udemy1::s13c::csv_to_movies_file(csv, path));
+    Scanned_movies from_csv;
+    from_csv.add_movie("Big", "PG-13", 2);
+    from_csv.add_movie("The Good, the Bad and the Ugly", "R", 7);
+    from_csv.add_movie("Say \"Cheese\"", "G", 0);
+    Movies_file converted{path};
+    ASSERT_TRUE(converted.is_open());
+    EXPECT_EQ(converted.size(), 3u);
+    EXPECT_EQ(listing(converted), listing(from_csv));
+
+    // a file that is not a catalog opens as an empty one
+    Movies_file not_catalog{csv};
+    EXPECT_FALSE(not_catalog.is_open());
+    EXPECT_EQ(not_catalog.size(), 0u);
+    EXPECT_FALSE(not_catalog.increment_watched("Big"));
+    std::filesystem::remove(path);
+    std::filesystem::remove(csv);
+}
+
+// the columns add, increment and list the movies a scan of the vector does, and the aggregates over
+// them are the ones worked out from the vector
+TEST(udemy_s13c_movie_table, same_as_scan)
+{
+    udemy1::s13c::Movie_table table;
+    Scanned_movies expected;
+    EXPECT_EQ(listing(table), listing(expected));
+    EXPECT_FALSE(table.increment_watched("Big"));
+
+    std::mt19937 rng{9};
+    for (int i{0}; i < 4000; ++i) {
+        const std::string title{movie_title(rng)};
+        if (title.starts_with("Unreleased") || rng() % 2) {
+            EXPECT_EQ(table.increment_watched(title), expected.increment_watched(title)) << title;
+        } else {
+            const std::string rating{movie_ratings[rng() % 4]};
+            const int watched{static_cast<int>(rng() % 10)};
+            EXPECT_EQ(table.add_movie(title, rating, watched), expected.add_movie(title, rating, watched)) << title;
+        }
+    }
+    EXPECT_EQ(listing(table), listing(expected));
+
+    const std::vector<udemy1::s13c::Movie>& movies{expected.all()};
+    ASSERT_EQ(table.size(), movies.size());
+    long long total{0};
+    std::vector<std::pair<std::string, long long>> by_rating;
+    for (std::size_t i{0}; i < movies.size(); ++i) {
+        const udemy1::s13c::Movie_row row{table.row(i)};
+        EXPECT_EQ(row.name, movies[i].getName());
+        EXPECT_EQ(row.rating, movies[i].getRating());
+        EXPECT_EQ(row.watched, movies[i].getWatched());
+        total += movies[i].getWatched();
+        auto it{std::find_if(by_rating.begin(), by_rating.end(),
+            [&](const auto& r) { return r.first == movies[i].getRating(); })};
+        if (it == by_rating.end())
+            it = by_rating.insert(it, {movies[i].getRating(), 0});
+        it->second += movies[i].getWatched();
+    }
+    EXPECT_EQ(table.total_watched(), total);
+    EXPECT_EQ(table.watched_by_rating(), by_rating);
+    EXPECT_EQ(table.total_watched("NC-17"), 0);
+    EXPECT_TRUE(table.top_watched(5, "NC-17").empty());
+
+    for (const char* rating : movie_ratings) {
+        std::vector<udemy1::s13c::Movie> rated;
+        std::copy_if(movies.begin(), movies.end(), std::back_inserter(rated),
+            [&](const udemy1::s13c::Movie& m) { return m.getRating() == rating; });
+        long long watched{0};
+        for (const udemy1::s13c::Movie& m : rated)
+            watched += m.getWatched();
+        EXPECT_EQ(table.total_watched(rating), watched) << rating;
+
+        // most watched first, ties in the order they were added
+        std::stable_sort(rated.begin(), rated.end(),
+            [](const udemy1::s13c::Movie& a, const udemy1::s13c::Movie& b) { return a.getWatched() > b.getWatched(); });
+        for (const std::size_t k : {std::size_t{0}, std::size_t{1}, std::size_t{7}, std::size_t{300}, rated.size()}) {
+            const std::vector<udemy1::s13c::Movie_row> top{table.top_watched(k, rating)};
+            ASSERT_EQ(top.size(), std::min(k, rated.size())) << rating << ", " << k;
+            for (std::size_t i{0}; i < top.size(); ++i) {
+                EXPECT_EQ(top[i].name, rated[i].getName()) << rating << ", " << k;
+                EXPECT_EQ(top[i].watched, rated[i].getWatched()) << rating << ", " << k;
+            }
+        }
+    }
+
+    // a rating is a byte, the 257th different one is not taken
+    udemy1::s13c::Movie_table many;
+    for (int i{0}; i < 256; ++i)
+        EXPECT_TRUE(many.add_movie("Feature #" + std::to_string(i), "rating " + std::to_string(i), 0));
+    EXPECT_FALSE(many.add_movie("Feature #256", "rating 256", 0));
+    EXPECT_TRUE(many.add_movie("Feature #256", "rating 0", 0));
+}
+
+TEST(udemy_s14c, valid_values)
+{
+    // capture cout
+    std::stringstream ss_out;
+    std::streambuf* orig_cout = std::cout.rdbuf(ss_out.rdbuf());
+
+    udemy1::s14c_run();
+
+    std::cout.rdbuf(orig_cout);
+
+    std::string result{"## Operator overloading challenge ##\n\n"};
+    result += "true\nfalse\nfalse\ntrue\ntrue\nfalse\n";
+    result += "frank\nfrank*****\nfrank*****-----\n";
+    result += "123451234512345\nabcdefabcdefabcdefabcdefabcdef\n";
+    result += "FRANK\nfrank\nFRANK\nFRANK\nFRANK\nfrank\nFRANK\nfrank\n";
+
+    EXPECT_EQ(ss_out.str(), result);
+}
+
+// an unordered_map of Mystring found by string_view and const char*, with the hash and == of a Mystring
+TEST(udemy_s14c_mystring, transparent_lookup)
+{
+    using udemy1::myclass::Mystring;
+    std::unordered_map<Mystring, int> counts;
+    const std::vector<std::string> keys{"", "a", "love", "Romeo and Juliet", std::string(100, 'x') + "y"};
+    for (std::size_t i{0}; i < keys.size(); ++i)
+        counts.emplace(Mystring{keys[i].c_str()}, static_cast<int>(i));
+
+    const std::hash<Mystring> hash;
+    const std::equal_to<Mystring> equal;
+    for (std::size_t i{0}; i < keys.size(); ++i) {
+        const Mystring key{keys[i].c_str()};
+        const std::string_view view{keys[i]};
+        EXPECT_EQ(hash(key), hash(view));
+        EXPECT_EQ(hash(key), hash(keys[i].c_str()));
+        EXPECT_TRUE(equal(key, view));
+        EXPECT_TRUE(equal(view, key));
+        EXPECT_TRUE(equal(keys[i].c_str(), key));
+
+        const auto found{counts.find(view)};
+        ASSERT_NE(found, counts.end()) << keys[i];
+        EXPECT_EQ(found->second, static_cast<int>(i));
+        EXPECT_EQ(counts.count(keys[i].c_str()), 1u);
+    }
+    EXPECT_FALSE(equal(Mystring{"love"}, std::string_view{"lov"}));
+    EXPECT_EQ(counts.find(std::string_view{"lov"}), counts.end());
+    EXPECT_EQ(counts.find("Juliet"), counts.end());
+    EXPECT_EQ(counts.count(std::string_view{std::string(100, 'x') + "z"}), 0u);
+}
+
+// every vector level the CPU has flips case and compares as the scalar kernel and std::strcmp do,
+// over the lengths around one and two 16 and 32 byte steps and their tails
+TEST(udemy_s14c_mystring, simd_same_as_scalar)
+{
+    using namespace udemy1::myclass::simd;
+    const auto sign{[](int v) { return (v > 0) - (v < 0); }};
+    // letters of both cases, the bytes next to them, and bytes with the high bit, never a '\0'
+    const std::string alphabet{"AZaz@[`{MmQq09 .\x7f\x80\xc1\xe1\xfa\xff"};
+    std::mt19937 rng{3};
+    std::vector<Level> levels{Level::scalar};
+    if (best_level() >= Level::sse2)
+        levels.push_back(Level::sse2);
+    if (best_level() >= Level::avx2)
+        levels.push_back(Level::avx2);
+
+    for (std::size_t n{0}; n <= 70; ++n)
+        for (int round{0}; round < 20; ++round) {
+            std::string text(n, ' ');
+            for (char& c : text)
+                c = alphabet[rng() % alphabet.size()];
+            for (const char first : {'A', 'a'}) {
+                std::string expected{text};
+                flip_case(expected.data(), n, first, Level::scalar);
+                for (const char c : expected)
+                    EXPECT_FALSE(c >= first && c < first + 26);
+                for (const Level level : levels) {
+                    std::string got{text};
+                    flip_case(got.data(), n, first, level);
+                    EXPECT_EQ(got, expected) << level_name(level) << ", " << n << " bytes";
+                }
+            }
+
+            // the same text but for one byte at i, or cut at i
+            std::string other{text};
+            const std::size_t i{n ? rng() % n : 0};
+            if (n)
+                other[i] = alphabet[rng() % alphabet.size()];
+            if (round % 4 == 3)
+                other.resize(i);
+            const int expected{sign(std::strcmp(text.c_str(), other.c_str()))};
+            for (const Level level : levels) {
+                EXPECT_EQ(sign(compare(text.data(), n, other.data(), other.size(), level)), expected)
+                    << level_name(level) << ", " << n << " bytes";
+                EXPECT_EQ(sign(compare(other.data(), other.size(), text.data(), n, level)), -expected)
+                    << level_name(level) << ", " << n << " bytes";
+                EXPECT_EQ(compare(text.data(), n, text.data(), n, level), 0) << level_name(level);
+            }
+            EXPECT_EQ(sign(compare(text.data(), n, other.data(), other.size())), expected);
+        }
+}
+
+// threads interning the same words at once get one handle a word, a table of its own hands out others
+TEST(udemy_s14c_atom, intern_from_threads)
+{
+    using udemy1::myclass::Atom;
+    using udemy1::myclass::Atom_table;
+    std::vector<std::string> words;
+    for (int i{0}; i < 500; ++i)
+        words.push_back("word" + std::to_string(i * 7919 % 1000));
+    words.push_back(std::string(100, 'x'));
+
+    Atom_table table;
+    std::vector<std::vector<Atom>> seen(8, std::vector<Atom>(words.size()));
+#pragma omp parallel for num_threads(8)
+    for (int t = 0; t < 8; ++t)
+        for (std::size_t k{0}; k < words.size(); ++k) {
+            const std::size_t i{(k + static_cast<std::size_t>(t) * 61) % words.size()}; // each thread in its own order
+            seen[t][i] = table.intern(words[i]);
+        }
+
+    EXPECT_EQ(table.size(), words.size());
+    Atom_table other;
+    for (std::size_t i{0}; i < words.size(); ++i) {
+        const Atom atom{table.intern(words[i])};
+        for (int t{0}; t < 8; ++t)
+            EXPECT_EQ(seen[t][i], atom) << words[i];
+        EXPECT_EQ(atom.view(), words[i]);
+        EXPECT_EQ(atom.getLength(), static_cast<int>(words[i].size()));
+        EXPECT_STREQ(atom.getStr(), words[i].c_str());
+        EXPECT_EQ(std::hash<Atom>{}(atom), atom.hash());
+
+        const Atom theirs{other.intern(words[i])};
+        EXPECT_NE(theirs, atom) << words[i];
+        EXPECT_EQ(theirs.view(), atom.view());
+    }
+    EXPECT_NE(table.intern(words[0]), table.intern(words[1]));
+
+    // "" is not stored, it is the default atom of every table
+    EXPECT_EQ(table.intern(""), Atom{});
+    EXPECT_EQ(other.intern(std::string_view{}), table.intern(""));
+    EXPECT_EQ(Atom{}.view(), std::string_view{});
+    EXPECT_EQ(Atom{}.getLength(), 0);
+    EXPECT_STREQ(Atom{}.getStr(), "");
+    EXPECT_EQ(table.size(), words.size());
+}
+
+namespace
+{
+// balance * rate / (100 * Rate::scale) with halves away from zero, the long way round
+std::int64_t exact_interest(std::int64_t balance, std::int64_t rate)
+{
+    __extension__ typedef __int128 int128;
+    const int128 d{100 * udemy1::Rate::scale};
+    const int128 p{static_cast<int128>(balance) * rate};
+    int128 q{p / d};
+    const int128 rem{p % d};
+    if (2 * (rem < 0 ? -rem : rem) >= d)
+        q += (p < 0 ? -1 : 1);
+    return static_cast<std::int64_t>(q);
+}
+} // namespace
+
+// doubles and interest round to the nearest cent, halves away from zero
+TEST(udemy_money, rounding)
+{
+    using udemy1::Money;
+    using udemy1::Rate;
+    EXPECT_EQ(Money::from_double(0.125).units(), 13);
+    EXPECT_EQ(Money::from_double(-0.125).units(), -13);
+    EXPECT_EQ(Money::from_double(1000.0).units(), 100000);
+    EXPECT_EQ(Rate::from_percent(1.5).units(), 1'500'000);
+    EXPECT_EQ(Money::from_units(-5) + Money::from_units(12) - Money::from_units(7), Money{});
+
+    EXPECT_EQ(udemy1::interest(Money::from_units(1), Rate::from_percent(50)).units(), 1);
+    EXPECT_EQ(udemy1::interest(Money::from_units(-1), Rate::from_percent(50)).units(), -1);
+    EXPECT_EQ(udemy1::interest(Money::from_units(1), Rate::from_units(49'999'999)).units(), 0);
+    EXPECT_EQ(udemy1::interest(Money::from_units(333), Rate::from_percent(1.5)).units(), 5); // 4.995
+    EXPECT_EQ(udemy1::interest(Money::from_units(-333), Rate::from_percent(1.5)).units(), -5);
+    EXPECT_EQ(udemy1::interest(Money::from_units(100'00), Rate::from_percent(3)).units(), 3'00);
+    EXPECT_EQ(udemy1::interest(Money::from_units(100'00), Rate::from_percent(-3)).units(), -3'00);
+}
+
+// a product past 64 bits is worked out in 128
+TEST(udemy_money, interest_past_64_bits)
+{
+    using udemy1::Money;
+    using udemy1::Rate;
+    const std::int64_t big{4'000'000'000'000'000'000};
+    EXPECT_EQ(udemy1::interest(Money::from_units(big), Rate::from_percent(100)).units(), big);
+    EXPECT_EQ(udemy1::interest(Money::from_units(-big), Rate::from_percent(100)).units(), -big);
+    EXPECT_EQ(udemy1::interest(Money::from_units(big + 1), Rate::from_percent(50)).units(), big / 2 + 1);
+    EXPECT_EQ(udemy1::interest(Money::from_units(90'000'000'00), Rate::from_percent(3)).units(), 2'700'000'00);
+}
+
+// every kernel on any threads gives the exact interest, the double fast path as well as the 128 bit one,
+// for accounts on both sides of 2^53, exact halves and a count that is not a whole number of blocks
+TEST(udemy_money, accrue_same_as_exact)
+{
+    using udemy1::Accrue_kernel;
+    using udemy1::Money;
+    using udemy1::Rate;
+    std::mt19937_64 rng{13};
+    std::vector<Money> balances;
+    std::vector<Rate> rates;
+    for (int i{0}; i < 10'007; ++i) {
+        const std::int64_t sign{rng() % 2 ? 1 : -1};
+        switch (i % 5) {
+        case 0: // a few dollars to a few million, any rate up to 20%
+            balances.push_back(Money::from_units(sign * static_cast<std::int64_t>(rng() % 500'000'000)));
+            rates.push_back(Rate::from_units(static_cast<std::int64_t>(rng() % 20'000'000)));
+            break;
+        case 1: // an odd number of cents at 50%, a half every time
+            balances.push_back(Money::from_units(sign * static_cast<std::int64_t>(rng() % 1'000'000 * 2 + 1)));
+            rates.push_back(Rate::from_percent(50));
+            break;
+        case 2: { // just under or over 2^53 for the product
+            const std::int64_t rate{static_cast<std::int64_t>(rng() % 10'000'000 + 1)};
+            const std::int64_t edge{(std::int64_t{1} << 53) / rate};
+            balances.push_back(Money::from_units(sign * (edge + static_cast<std::int64_t>(rng() % 5) - 2)));
+            rates.push_back(Rate::from_units(rate));
+            break;
+        }
+        case 3: // far past 2^53
+            balances.push_back(Money::from_units(sign * static_cast<std::int64_t>(rng() % 1'000'000'000'000'000)));
+            rates.push_back(Rate::from_units(static_cast<std::int64_t>(rng() % 100'000'000)));
+            break;
+        default: // negative rates and none
+            balances.push_back(Money::from_units(static_cast<std::int64_t>(rng() % 100'000'000)));
+            rates.push_back(Rate::from_units(i % 2 ? 0 : -static_cast<std::int64_t>(rng() % 5'000'000)));
+        }
+    }
+    // and the same accounts without those past 2^53, so whole blocks take the double path
+    std::vector<Money> small_balances;
+    std::vector<Rate> small_rates;
+    for (std::size_t i{0}; i < balances.size(); ++i)
+        if (std::fabs(static_cast<double>(balances[i].units()) * static_cast<double>(rates[i].units())) < 0x1p53) {
+            small_balances.push_back(balances[i]);
+            small_rates.push_back(rates[i]);
+        }
+
+    for (const auto& [accounts, account_rates] :
+        {std::pair{&balances, &rates}, std::pair{&small_balances, &small_rates}}) {
+        std::vector<Money> expected{*accounts};
+        for (std::size_t i{0}; i < expected.size(); ++i)
+            expected[i] += Money::from_units(exact_interest((*accounts)[i].units(), (*account_rates)[i].units()));
+        for (std::size_t i{0}; i < expected.size(); i += 97)
+            EXPECT_EQ((*accounts)[i] + udemy1::interest((*accounts)[i], (*account_rates)[i]), expected[i]);
+
+        for (const Accrue_kernel kernel : {Accrue_kernel::portable, Accrue_kernel::avx512})
+            for (const int threads : {1, 4}) {
+                std::vector<Money> accrued{*accounts};
+                udemy1::accrue_interest(accrued, *account_rates, threads, kernel);
+                EXPECT_EQ(accrued, expected) << static_cast<int>(kernel) << ", " << threads << " threads";
+            }
+    }
+}
+
+// the ledger applies the same rules as the s15c classes, one call at a time
+TEST(udemy_s15c_ledger, same_as_account_classes)
+{
+    using namespace udemy1::s15c;
+    using udemy1::Money;
+    using udemy1::Rate;
+
+    Checking_Account checking{"Checking", 1000.0};
+    Savings_Account savings{"Savings", 1000.0, 2.0};
+    Trust_Account trust{"Trust", 20000.0, 2.0};
+    Ledger ledger;
+    ledger.open(Kind::checking, Money::from_double(1000.0));
+    ledger.open(Kind::savings, Money::from_double(1000.0), Rate::from_percent(2.0));
+    ledger.open(Kind::trust, Money::from_double(20000.0), Rate::from_percent(2.0));
+
+    // whole dollars, so the doubles of the classes stay exact
+    std::mt19937 rng{15};
+    for (int i{0}; i < 3000; ++i) {
+        const double amt{static_cast<double>(rng() % 6000)};
+        const bool deposit{rng() % 2 == 0};
+        const std::uint32_t account{static_cast<std::uint32_t>(i % 3)};
+        bool expected{false};
+        switch (account) {
+        case 0: expected = deposit ? checking.deposit(amt) : checking.withdraw(amt); break;
+        case 1: expected = deposit ? savings.deposit(amt) : savings.withdraw(amt); break;
+        default: expected = deposit ? trust.deposit(amt) : trust.withdraw(amt); break;
+        }
+        const Money m{Money::from_double(amt)};
+        EXPECT_EQ(deposit ? ledger.deposit(account, m) : ledger.withdraw(account, m), expected) << "posting " << i;
+    }
+    EXPECT_EQ(ledger.balance(0), Money::from_double(checking.get_balance()));
+    EXPECT_EQ(ledger.balance(1), Money::from_double(savings.get_balance()));
+    EXPECT_EQ(ledger.balance(2), Money::from_double(trust.get_balance()));
+}
+
+// threads racing to withdraw from and deposit to a few accounts, nothing is lost or made up
+TEST(udemy_s15c_ledger, stress_no_negative_balance)
+{
+    using namespace udemy1::s15c;
+    using udemy1::Money;
+
+    constexpr int accounts{4};
+    constexpr int ops{200'000};
+    Ledger ledger;
+    for (int i{0}; i < accounts; ++i)
+        ledger.open(Kind::account, Money::from_units(10'000));
+
+    std::vector<long long> net(accounts, 0); // successful deposits - withdrawals, in cents
+    bool negative_seen{false};
+#pragma omp parallel num_threads(8)
+    {
+        std::mt19937 rng{static_cast<unsigned>(omp_get_thread_num())};
+        std::vector<long long> local(accounts, 0);
+        bool local_negative{false};
+#pragma omp for
+        for (int i = 0; i < ops; ++i) {
+            const std::uint32_t account{static_cast<std::uint32_t>(rng() % accounts)};
+            const Money amt{Money::from_units(static_cast<std::int64_t>(rng() % 5000))};
+            if (rng() % 3 == 0) {
+                if (ledger.deposit(account, amt))
+                    local[account] += amt.units();
+            } else if (ledger.withdraw(account, amt)) {
+                local[account] -= amt.units();
+            }
+            local_negative |= ledger.balance(account) < Money{};
+        }
+#pragma omp critical
+        {
+            for (int a{0}; a < accounts; ++a)
+                net[a] += local[a];
+            negative_seen |= local_negative;
+        }
+    }
+    EXPECT_FALSE(negative_seen);
+    for (std::uint32_t a{0}; a < accounts; ++a)
+        EXPECT_EQ(ledger.balance(a).units(), 10'000 + net[a]);
+}
+
+// however many threads try, a trust account allows exactly 3 withdrawals per period
+TEST(udemy_s15c_ledger, stress_trust_withdrawal_cap)
+{
+    using namespace udemy1::s15c;
+    using udemy1::Money;
+
+    Ledger ledger;
+    const std::uint32_t trust{ledger.open(Kind::trust, Money::from_double(1'000'000.0))};
+    for (int period{0}; period < 50; ++period) {
+        int allowed{0};
+#pragma omp parallel for num_threads(8) reduction(+ : allowed)
+        for (int i = 0; i < 1000; ++i)
+            allowed += ledger.withdraw(trust, Money::from_double(1.0));
+        EXPECT_EQ(allowed, 3);
+        EXPECT_EQ(ledger.withdrawals(trust), 3);
+        ledger.new_period();
+    }
+    EXPECT_EQ(ledger.balance(trust), Money::from_double(1'000'000.0 - 50 * 3));
+}
+
+namespace
+{
+// a child process deposits 1 cent at a time into account 0 of a journaled ledger and reports,
+// through a pipe, how many deposits it knows to be durable, until the parent kills it
+int journal_until_killed(const std::string& path, udemy1::s15c::Durability durability, int commit_every,
+                         int kill_after)
+{
+    using namespace udemy1::s15c;
+    int fds[2];
+    if (::pipe(fds) != 0)
+        return -1;
+    const pid_t child{::fork()};
+    if (child == 0) {
+        ::close(fds[0]);
+        Journaled_ledger journal{path, durability, 64};
+        std::uint32_t account{0};
+        journal.open(Kind::account, udemy1::Money{}, udemy1::Rate{}, account);
+        journal.commit();
+        for (int done{1};; ++done) {
+            journal.deposit(account, udemy1::Money::from_units(1));
+            if (done % commit_every == 0 && (durability == Durability::per_op || journal.commit()))
+                if (::write(fds[1], &done, sizeof done) != sizeof done)
+                    ::_exit(1);
+        }
+    }
+    ::close(fds[1]);
+    int durable{0}, got{0};
+    while (durable < kill_after && ::read(fds[0], &got, sizeof got) == sizeof got)
+        durable = got;
+    ::kill(child, SIGKILL);
+    ::waitpid(child, nullptr, 0);
+    ::close(fds[0]);
+    return durable;
+}
+} // namespace
+
+// killed between two fsyncs, everything acknowledged comes back and nothing half written
+TEST(udemy_s15c_journal, recovers_after_kill_per_op)
+{
+    using namespace udemy1::s15c;
+    const std::string path{(std::filesystem::temp_directory_path() / "udemy1_journal_per_op").string()};
+    std::filesystem::remove(path + ".journal");
+    std::filesystem::remove(path + ".snapshot");
+
+    const int acked{journal_until_killed(path, Durability::per_op, 1, 500)};
+    ASSERT_GE(acked, 500);
+
+    Journaled_ledger journal{path, Durability::per_op};
+    ASSERT_TRUE(journal.is_open());
+    ASSERT_EQ(journal.ledger().size(), 1u);
+    const std::int64_t cents{journal.ledger().balance(0).units()};
+    EXPECT_GE(cents, acked);
+    EXPECT_LE(cents, acked + 1); // the deposit in flight may or may not have made it
+    EXPECT_EQ(std::filesystem::file_size(path + ".journal") % 40, 0u);
+    EXPECT_TRUE(journal.deposit(0, udemy1::Money::from_units(1)));
+}
+
+// killed in the middle of a batch, the last committed batch is there, and the recovered
+// journal is a whole prefix of what the child wrote
+TEST(udemy_s15c_journal, recovers_after_kill_mid_batch)
+{
+    using namespace udemy1::s15c;
+    const std::string path{(std::filesystem::temp_directory_path() / "udemy1_journal_batched").string()};
+    std::filesystem::remove(path + ".journal");
+    std::filesystem::remove(path + ".snapshot");
+
+    const int committed{journal_until_killed(path, Durability::batched, 1000, 20'000)};
+    ASSERT_GE(committed, 20'000);
+
+    std::int64_t cents{0};
+    {
+        Journaled_ledger journal{path, Durability::batched};
+        ASSERT_TRUE(journal.is_open());
+        cents = journal.ledger().balance(0).units();
+        EXPECT_GE(cents, committed);
+        EXPECT_EQ(static_cast<std::int64_t>(journal.replayed()), cents + 1); // the open and every deposit
+    }
+
+    // a torn record at the end is cut off
+    {
+        std::ofstream torn{path + ".journal", std::ios::binary | std::ios::app};
+        torn.write("half a record", 13);
+    }
+    Journaled_ledger journal{path, Durability::batched};
+    ASSERT_TRUE(journal.is_open());
+    EXPECT_EQ(journal.ledger().balance(0).units(), cents);
+    EXPECT_EQ(std::filesystem::file_size(path + ".journal") % 40, 0u);
+}
+
+// snapshots plus the journal after them give back the same accounts
+TEST(udemy_s15c_journal, snapshot_and_replay)
+{
+    using namespace udemy1::s15c;
+    using udemy1::Money;
+    const std::string path{(std::filesystem::temp_directory_path() / "udemy1_journal_snapshot").string()};
+    std::filesystem::remove(path + ".journal");
+    std::filesystem::remove(path + ".snapshot");
+
+    Ledger expected;
+    {
+        Journaled_ledger journal{path, Durability::none, 64, 250};
+        std::uint32_t account{0};
+        for (Kind k : {Kind::account, Kind::checking, Kind::savings, Kind::trust}) {
+            ASSERT_TRUE(journal.open(k, Money::from_units(100'000'00), udemy1::Rate::from_percent(1.5), account));
+            expected.open(k, Money::from_units(100'000'00), udemy1::Rate::from_percent(1.5));
+        }
+        std::mt19937 rng{24};
+        for (int i{0}; i < 1000; ++i) {
+            const std::uint32_t a{static_cast<std::uint32_t>(rng() % 4)};
+            const Money amt{Money::from_units(static_cast<std::int64_t>(rng() % 700'000))};
+            if (i % 300 == 0) {
+                journal.new_period();
+                expected.new_period();
+            } else if (rng() % 2 == 0) {
+                EXPECT_EQ(journal.deposit(a, amt), expected.deposit(a, amt));
+            } else {
+                EXPECT_EQ(journal.withdraw(a, amt), expected.withdraw(a, amt));
+            }
+        }
+    }
+    Journaled_ledger journal{path, Durability::none};
+    ASSERT_TRUE(journal.is_open());
+    EXPECT_LT(journal.replayed(), 250u);
+    ASSERT_EQ(journal.ledger().size(), expected.size());
+    for (std::uint32_t a{0}; a < expected.size(); ++a) {
+        EXPECT_EQ(journal.ledger().balance(a), expected.balance(a));
+        EXPECT_EQ(journal.ledger().withdrawals(a), expected.withdrawals(a));
+    }
+}
+
+// the sink writes the bytes operator<< does for every kind of account, through more than one buffer,
+// and leaves the stream fixed with the precision of the last Fixed, as operator<< does
+TEST(udemy_s16c_print_sink, same_as_stream)
+{
+    using namespace udemy1::s16c;
+    Account_pool pool;
+    const double odd[]{0.0, -0.0, 0.005, 0.015, 2.675, 1e-9, 1234567.895, 1e15 + 0.3, 1e300, -42.125};
+    for (int i{0}; i < 3000; ++i) {
+        const std::string name{"Holder " + std::to_string(i)};
+        const double balance{odd[i % 10] + i / 3};
+        switch (i % 3) {
+        case 0: pool.make<Checking>(name, balance); break;
+        case 1: pool.make<Savings>(name, balance, odd[i % 7] + 0.1 * i); break;
+        default: pool.make<Trust>(name, balance, 1.5)->withdraw(i % 5); break;
+        }
+    }
+
+    std::ostringstream by_stream, by_sink;
+    for (const Account* acc : pool.accounts())
+        by_stream << *acc << '\n';
+    by_sink.precision(9);
+    by_sink.setf(std::ios::scientific, std::ios::floatfield);
+    {
+        udemy1::Print_sink out{by_sink};
+        for (const Account* acc : pool.accounts())
+            out << *acc << '\n';
+        out.flush();
+        EXPECT_GT(by_sink.str().size(), udemy1::Print_sink::capacity);
+        EXPECT_EQ(by_sink.str(), by_stream.str());
+        EXPECT_EQ(by_sink.flags() & std::ios::floatfield, std::ios::fixed);
+        EXPECT_EQ(by_sink.precision(), 2);
+        EXPECT_EQ(by_sink.flags() & std::ios::floatfield, by_stream.flags() & std::ios::floatfield);
+        EXPECT_EQ(by_sink.precision(), by_stream.precision());
+
+        // the last Fixed since the flush sets the precision, a flush without one leaves the stream as it is
+        by_sink.str("");
+        out << udemy1::Fixed{1.0 / 3, 4} << ' ' << udemy1::Fixed{2.0 / 3, 1};
+        out.flush();
+        EXPECT_EQ(by_sink.str(), "0.3333 0.7");
+        EXPECT_EQ(by_sink.precision(), 1);
+        by_sink.precision(5);
+        out << ' ' << 42 << "!";
+        out.flush();
+        EXPECT_EQ(by_sink.str(), "0.3333 0.7 42!");
+        EXPECT_EQ(by_sink.precision(), 5);
+        EXPECT_EQ(by_sink.flags() & std::ios::floatfield, std::ios::fixed);
+    }
+}
+
+namespace
+{
+// a text of about bytes bytes with what >> and clean_string make something of: runs of every
+// whitespace, words of only . , ; : and lines without a word, the last line has no '\n'
+std::string sample_text(std::size_t bytes, unsigned seed)
+{
+    static const char* const words[]{"love", "Romeo,", "Juliet.", "beloved;", "glove:", "O", "e", "ROMEO", "...",
+        "Tybalt's", "thee", "lo", "ve", "l;ove", "Jul:iet", "night", ",", "w"};
+    static const char* const spaces[]{" ", " ", " ", "  ", "\t", " \v", "\r ", "\f", "\n", "\n\n", "\n \n"};
+    std::mt19937 rng{seed};
+    std::string text;
+    while (text.size() < bytes) {
+        text += words[rng() % std::size(words)];
+        if (rng() % 4 == 0)
+            text += std::to_string(rng() % 500);
+        text += spaces[rng() % std::size(spaces)];
+    }
+    return text + "last";
+}
+
+// the words the >> loop of find_word_count reads, and how many of them contain each target
+std::size_t find_loop(const std::string& text, const std::vector<std::string>& targets, std::vector<std::size_t>& found)
+{
+    found.assign(targets.size(), 0);
+    std::size_t words{0};
+    std::istringstream in{text};
+    std::string word;
+    while (in >> word) {
+        ++words;
+        for (std::size_t t{0}; t < targets.size(); ++t)
+            if (word.find(targets[t]) != std::string::npos)
+                ++found[t];
+    }
+    return words;
+}
+
+// part1 of s20c3 without the file
+std::map<std::string, int> part1_words(const std::string& text)
+{
+    std::map<std::string, int> words;
+    std::istringstream in{text};
+    std::string word;
+    while (in >> word)
+        ++words[udemy1::s20c3::clean_string(word)];
+    return words;
+}
+
+template <typename Entry>
+void expect_part1(const std::vector<Entry>& got, const std::map<std::string, int>& expected)
+{
+    ASSERT_EQ(got.size(), expected.size());
+    auto it{expected.begin()};
+    for (const Entry& e : got) {
+        EXPECT_EQ(e.word, it->first);
+        EXPECT_EQ(e.count, static_cast<std::size_t>(it->second)) << e.word;
+        ++it;
+    }
+}
+
+// part2 of s20c3 without the file
+std::map<std::string, std::set<int>> part2_words(const std::string& text)
+{
+    std::map<std::string, std::set<int>> words;
+    std::istringstream in{text};
+    std::string line, word;
+    int line_no{0};
+    while (std::getline(in, line)) {
+        ++line_no;
+        std::istringstream ss{line};
+        while (ss >> word)
+            words[udemy1::s20c3::clean_string(word)].insert(line_no);
+    }
+    return words;
+}
+
+void expect_part2(const std::vector<udemy1::s20c3::Line_table::Entry>& got,
+    const std::map<std::string, std::set<int>>& expected)
+{
+    ASSERT_EQ(got.size(), expected.size());
+    auto it{expected.begin()};
+    for (const udemy1::s20c3::Line_table::Entry& e : got) {
+        EXPECT_EQ(e.word, it->first);
+        EXPECT_TRUE(std::equal(e.lines.begin(), e.lines.end(), it->second.begin(), it->second.end())) << e.word;
+        ++it;
+    }
+}
+
+std::string file_bytes(const std::string& file_name)
+{
+    std::ifstream in{file_name, std::ios::binary};
+    return std::string{std::istreambuf_iterator<char>{in}, {}};
+}
+} // namespace
+
+// count_words counts what the >> and find loop of find_word_count does
+TEST(udemy_s19c3_search, same_as_find_loop)
+{
+    using namespace udemy1::s19c3;
+    const std::vector<std::string> targets{"love", "Romeo", "e", "l;ove", "ve,", "Frank", "", "a b", "o\t"};
+    for (const std::string& text : {sample_text(3 << 20, 19), sample_text(100, 18), std::string{}, std::string{" \t"},
+             std::string{"love"}, std::string{"glove love\n"}}) {
+        std::vector<std::size_t> expected;
+        const std::size_t words{find_loop(text, targets, expected)};
+        for (std::size_t t{0}; t < targets.size(); ++t) {
+            const Word_count count{count_words(text, targets[t])};
+            EXPECT_EQ(count.words, words) << targets[t];
+            EXPECT_EQ(count.matches, expected[t]) << targets[t];
+        }
+    }
+}
+
+// count_words_parallel counts what count_words does however many threads cut the text
+TEST(udemy_s19c3_search, parallel_same_as_find_loop)
+{
+    using namespace udemy1::s19c3;
+    const std::string text{sample_text(5 << 20, 19)};
+    const std::vector<std::string> targets{"love", "e", "ve,", ""};
+    std::vector<std::size_t> expected;
+    const std::size_t words{find_loop(text, targets, expected)};
+
+    for (const int threads : {1, 2, 3, 8})
+        for (std::size_t t{0}; t < targets.size(); ++t) {
+            const Word_count count{count_words_parallel(text, targets[t], threads)};
+            EXPECT_EQ(count.words, words) << threads << " threads, " << targets[t];
+            EXPECT_EQ(count.matches, expected[t]) << threads << " threads, " << targets[t];
+        }
+}
+
+// Keyword_counter counts every keyword in one pass as the find loop does one at a time
+TEST(udemy_s19c3_keywords, same_as_find_loop)
+{
+    using udemy1::s19c3::Keyword_counter;
+    const std::string text{sample_text(1 << 20, 20)};
+    // repeated, empty, with whitespace, one inside another and sharing prefixes and suffixes
+    const std::vector<std::string> keywords{"love", "Romeo", "e", "l;ove", "ve,", "Frank", "", "a b", "love", "o",
+        "lo", "ove", "ROMEO", "Juliet.", "\xe9t\xe9", "night1", "1"};
+    std::vector<std::size_t> expected;
+    const std::size_t words{find_loop(text, keywords, expected)};
+
+    const Keyword_counter counter{keywords};
+    EXPECT_EQ(counter.size(), keywords.size());
+    std::vector<std::size_t> counts;
+    EXPECT_EQ(counter.count(text, counts), words);
+    EXPECT_EQ(counts, expected);
+
+    EXPECT_EQ(counter.count("", counts), 0u);
+    EXPECT_EQ(counts, std::vector<std::size_t>(keywords.size(), 0));
+}
+
+// Word_table holds the words and counts the std::map of part1 does, in its order
+TEST(udemy_s20c3_count, same_as_part1)
+{
+    using namespace udemy1::s20c3;
+    for (const std::string& text : {sample_text(3 << 20, 21), sample_text(100, 22), std::string{},
+             std::string{"... ,"}, std::string{"a:b a.b ab\n"}}) {
+        Word_table words;
+        count_words(text, words);
+        expect_part1(words.sorted(), part1_words(text));
+    }
+}
+
+// the parallel tables and Line_table hold what the std::map of part1 and part2 do, on any threads
+TEST(udemy_s20c3_count, parallel_same_as_maps)
+{
+    using namespace udemy1::s20c3;
+    const std::string text{sample_text(3 << 20, 22)};
+    const std::map<std::string, int> expected1{part1_words(text)};
+    const std::map<std::string, std::set<int>> expected2{part2_words(text)};
+
+    Line_table lines;
+    index_words(text, lines);
+    expect_part1(lines.sorted(), expected1);
+    expect_part2(lines.sorted(), expected2);
+    for (const int threads : {1, 3, 8}) {
+        const std::vector<Word_table> words_parts{count_words_parallel(text, threads)};
+        expect_part1(sorted(words_parts), expected1);
+        const std::vector<Line_table> lines_parts{index_words_parallel(text, threads)};
+        expect_part1(sorted(lines_parts), expected1);
+        expect_part2(sorted(lines_parts), expected2);
+    }
+}
+
+// an index brought up to a longer text by appended() saves the bytes a full build of that text does
+TEST(udemy_s20c3_index, appended_same_as_build)
+{
+    using udemy1::s20c3::Line_index;
+    const std::filesystem::path dir{std::filesystem::temp_directory_path()};
+    const std::string index_file{(dir / "udemy1_index_appended").string()};
+    const std::string built_file{(dir / "udemy1_index_built").string()};
+    const std::string text{sample_text(3 << 20, 25)};
+    const std::size_t mid_line{text.find('\n', text.size() / 3) - 2};
+
+    ASSERT_TRUE(udemy1::s20c3::build_index(std::string_view{text}.substr(0, mid_line), 2).save(index_file));
+    // within the last line, from the next line on, then nothing more
+    for (const std::size_t upto : {mid_line + 1, text.find('\n', text.size() / 2) + 1, text.size(), text.size()}) {
+        const std::string_view longer{std::string_view{text}.substr(0, upto)};
+        const Line_index saved{index_file, udemy1::Mapped_file::Access::sequential};
+        ASSERT_TRUE(saved.is_open());
+        ASSERT_TRUE(saved.appended(longer, 2).save(index_file));
+        ASSERT_TRUE(udemy1::s20c3::build_index(longer, 2).save(built_file));
+        EXPECT_EQ(file_bytes(index_file), file_bytes(built_file)) << upto;
+    }
+    std::filesystem::remove(index_file);
+    std::filesystem::remove(built_file);
+}
+
+// an index file with a term out of its blocks is not opened, and update_index builds it again
+TEST(udemy_s20c3_index, bad_term_not_opened)
+{
+    using udemy1::s20c3::Line_index;
+    const std::filesystem::path dir{std::filesystem::temp_directory_path()};
+    const std::string text_file{(dir / "udemy1_index_text").string()};
+    const std::string index_file{(dir / "udemy1_index_bad").string()};
+    const std::string rebuilt_file{(dir / "udemy1_index_rebuilt").string()};
+    std::string text;
+    for (int i{0}; i < 50; ++i)
+        text += "love and Romeo, Juliet " + std::to_string(i % 7) + "\n";
+    std::ofstream{text_file, std::ios::binary} << text;
+    ASSERT_TRUE(udemy1::s20c3::build_index(text).save(rebuilt_file));
+    const std::string expected{file_bytes(rebuilt_file)};
+
+    // one byte flipped: the word, the lines and the postings of the first term out of their blocks,
+    // and the last byte of the file, the last gap, going on past the end
+    constexpr std::streamoff term{72}; // after the File_header of version 2
+    const std::pair<std::streamoff, char> damages[]{{term + offsetof(Line_index::Term, length) + 1, 0x04},
+        {term + offsetof(Line_index::Term, lines) + 1, 0x04}, {term + offsetof(Line_index::Term, postings) + 1, 0x04},
+        {-1, static_cast<char>(0x80)}};
+    for (const auto& [at, flip] : damages) {
+        ASSERT_TRUE(udemy1::s20c3::update_index(text_file, index_file));
+        ASSERT_TRUE(Line_index{index_file}.is_open());
+        {
+            std::fstream f{index_file, std::ios::binary | std::ios::in | std::ios::out};
+            const std::ios::seekdir from{at < 0 ? std::ios::end : std::ios::beg};
+            f.seekg(at, from);
+            char c{0};
+            f.get(c);
+            f.seekp(at, from);
+            f.put(static_cast<char>(c ^ flip));
+        }
+        EXPECT_FALSE(Line_index{index_file}.is_open());
+
+        ASSERT_TRUE(udemy1::s20c3::update_index(text_file, index_file));
+        EXPECT_EQ(file_bytes(index_file), expected);
+        std::filesystem::remove(index_file);
+    }
+    std::filesystem::remove(text_file);
+    std::filesystem::remove(rebuilt_file);
+}
+
 /*
 // Template
 TEST(udemy_s4c, valid_values)